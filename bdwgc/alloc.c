@@ -306,6 +306,13 @@ GC_INNER GC_bool GC_should_collect(void)
                         /* Not called if 0.  Called with the allocation */
                         /* lock held.  Not used by GC itself.           */
 
+/* STATIC */ void (*GC_world_stop_call_back) (int) = 0;
+                        /* Called with a nonzero argument before a      */
+                        /* collection stops the world to mark, and with */
+                        /* zero once the world has been restarted.      */
+                        /* Not called if 0.  Called with the allocation */
+                        /* lock held.  Not used by GC itself.           */
+
 GC_INLINE void GC_notify_full_gc(void)
 {
     if (GC_start_call_back != 0) {
@@ -581,6 +588,8 @@ STATIC GC_bool GC_stopped_mark(GC_stop_func stop_func)
         GET_TIME(start_time);
 #   endif
 
+    if (GC_world_stop_call_back != 0)
+      (*GC_world_stop_call_back)(1);
     STOP_WORLD();
 #   ifdef THREAD_LOCAL_ALLOC
       GC_world_stopped = TRUE;
@@ -613,6 +622,8 @@ STATIC GC_bool GC_stopped_mark(GC_stop_func stop_func)
                       GC_world_stopped = FALSE;
 #                   endif
                     START_WORLD();
+                    if (GC_world_stop_call_back != 0)
+                      (*GC_world_stop_call_back)(0);
                     return(FALSE);
             }
             if (GC_mark_some((ptr_t)(&dummy))) break;
@@ -635,6 +646,8 @@ STATIC GC_bool GC_stopped_mark(GC_stop_func stop_func)
       GC_world_stopped = FALSE;
 #   endif
     START_WORLD();
+    if (GC_world_stop_call_back != 0)
+      (*GC_world_stop_call_back)(0);
 #   ifndef SMALL_CONFIG
       if (GC_print_stats) {
         unsigned long time_diff;
@@ -665,6 +678,29 @@ STATIC GC_bool GC_stopped_mark(GC_stop_func stop_func)
     return(TRUE);
 }
 
+GC_API void * GC_CALL GC_call_with_world_stopped(GC_fn_type fn,
+                                                 void *client_data)
+{
+    void *result;
+    DCL_LOCK_STATE;
+
+    LOCK();
+#   ifdef PARALLEL_MARK
+      if (GC_parallel) GC_wait_for_reclaim();
+#   endif
+    STOP_WORLD();
+#   ifdef THREAD_LOCAL_ALLOC
+      GC_world_stopped = TRUE;
+#   endif
+    result = (*fn)(client_data);
+#   ifdef THREAD_LOCAL_ALLOC
+      GC_world_stopped = FALSE;
+#   endif
+    START_WORLD();
+    UNLOCK();
+    return result;
+}
+
 /* Set all mark bits for the free list whose first entry is q   */
 GC_INNER void GC_set_fl_marks(ptr_t q)
 {
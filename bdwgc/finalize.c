@@ -83,6 +83,10 @@ static signed_word log_fo_table_size = -1;
 
 word GC_fo_entries = 0; /* used also in extra/MacOS.c */
 
+STATIC word GC_registration_count = 0;
+                        /* Finalizers and disappearing links ever       */
+                        /* registered, see GC_get_registration_count.   */
+
 GC_INNER void GC_push_finalizer_structures(void)
 {
     GC_push_all((ptr_t)(&dl_head), (ptr_t)(&dl_head) + sizeof(word));
@@ -205,6 +209,7 @@ GC_API int GC_CALL GC_general_register_disappearing_link(void * * link,
     dl_set_next(new_dl, dl_head[index]);
     dl_head[index] = new_dl;
     GC_dl_entries++;
+    GC_registration_count++;
     UNLOCK();
     return GC_SUCCESS;
 }
@@ -418,6 +423,7 @@ STATIC void GC_register_finalizer_inner(void * obj,
     new_fo -> fo_mark_proc = mp;
     fo_set_next(new_fo, fo_head[index]);
     GC_fo_entries++;
+    GC_registration_count++;
     fo_head[index] = new_fo;
     UNLOCK();
 }
@@ -787,6 +793,24 @@ GC_API int GC_CALL GC_should_invoke_finalizers(void)
     return GC_finalize_now != 0;
 }
 
+GC_API GC_word GC_CALL GC_get_registration_count(void)
+{
+    return GC_registration_count;
+}
+
+GC_API GC_word GC_CALL GC_get_finalizer_queue_length(void)
+{
+    struct finalizable_object * curr_fo;
+    GC_word count = 0;
+    DCL_LOCK_STATE;
+
+    LOCK();
+    for (curr_fo = GC_finalize_now; curr_fo != 0; curr_fo = fo_next(curr_fo))
+        ++count;
+    UNLOCK();
+    return count;
+}
+
 /* Invoke finalizers for all objects that are ready to be finalized.    */
 /* Should be called without allocation lock.                            */
 GC_API int GC_CALL GC_invoke_finalizers(void)
@@ -935,6 +935,11 @@ GC_API int GC_CALL GC_unregister_disappearing_link(void ** /* link */);
 /* Returns !=0 if GC_invoke_finalizers has something to do.     */
 GC_API int GC_CALL GC_should_invoke_finalizers(void);
 
+/* Returns the number of objects that are ready to be finalized, that  */
+/* is, the length of the queue drained by GC_invoke_finalizers.  The   */
+/* queue is walked with the allocation lock held.                      */
+GC_API GC_word GC_CALL GC_get_finalizer_queue_length(void);
+
 GC_API int GC_CALL GC_invoke_finalizers(void);
         /* Run finalizers for all objects that are ready to     */
         /* be finalized.  Return the number of finalizers       */
@@ -207,10 +207,79 @@ GC_API void GC_CALL GC_register_describe_type_fn(int /* kind */,
                                 /* to be used when printing objects     */
                                 /* of a particular kind.                */
 
+/* Return the kind of the object whose base address is p, and store    */
+/* its size in *psize, unless psize is NULL.                            */
+GC_API int GC_CALL GC_get_kind_and_size(const void * /* p */,
+                                        size_t * /* psize */);
+
+typedef void (GC_CALLBACK * GC_reachable_object_proc)(void * /* obj */,
+                                                size_t /* bytes */,
+                                                void * /* client_data */);
+                                /* Invoked for each object found by     */
+                                /* the following function.              */
+
+/* Call proc for every object which has its mark bit set, i.e. for all  */
+/* the objects found reachable by the last collection and those         */
+/* allocated black since then.  The result is only meaningful right     */
+/* after a full collection.  The caller holds the allocation lock.      */
+GC_API void GC_CALL GC_enumerate_reachable_objects_inner(
+                                        GC_reachable_object_proc,
+                                        void * /* client_data */);
+
 /* See gc.h for the description of these "inner" functions.             */
 GC_API size_t GC_CALL GC_get_heap_size_inner(void);
 GC_API size_t GC_CALL GC_get_free_bytes_inner(void);
 
+/* Tracking of the writes to the heap, which lets a client find all     */
+/* the references to a set of objects that it allocated recently, for  */
+/* instance to check that they can be explicitly deallocated.  With on  */
+/* nonzero, start recording the heap pages which contain pointers and   */
+/* are written from now on, turning on the virtual dirty bits without   */
+/* incremental collection if needed.  Calls nest: each one must be      */
+/* matched by a call with on zero, and the record covers the writes     */
+/* since the oldest pending call.  Returns zero, and records nothing,   */
+/* if this is not supported on this platform.                           */
+GC_API int GC_CALL GC_track_writes(int /* on */);
+
+typedef void (GC_CALLBACK * GC_scan_range_proc)(void * /* lo */,
+                                                void * /* hi */,
+                                                void * /* client_data */);
+                                /* Invoked for each range of memory     */
+                                /* found by the following functions.    */
+
+/* Call fn with the allocation lock held and all the other threads      */
+/* stopped, and return its result.  fn must not allocate.               */
+GC_API void * GC_CALL GC_call_with_world_stopped(GC_fn_type /* fn */,
+                                                 void * /* client_data */);
+
+/* Call proc on every page of the heap which may contain pointers and   */
+/* may have been written since writes are tracked.  Pages written       */
+/* before that may be included too.  The world must be stopped.         */
+GC_API void GC_CALL GC_scan_written_pages(GC_scan_range_proc,
+                                          void * /* client_data */);
+
+/* Forget the pages written so far, so that GC_scan_written_pages()   */
+/* only returns those written from now on, if the caller is the only   */
+/* one tracking writes.  The world must be stopped.  The collector     */
+/* still sees these pages as dirty.                                     */
+GC_API void GC_CALL GC_clear_written_pages(void);
+
+/* Call proc on the roots registered with GC_add_roots() and on the    */
+/* stacks of all the threads, including their saved registers.  The    */
+/* world must be stopped.                                               */
+GC_API void GC_CALL GC_scan_roots(GC_scan_range_proc,
+                                  void * /* client_data */);
+
+/* The number of finalizers and disappearing links registered so far.  */
+/* Read without the allocation lock.                                    */
+GC_API GC_word GC_CALL GC_get_registration_count(void);
+
+/* Deallocate the n objects of the array as GC_free() does.  The       */
+/* allocation lock must be held, for instance by a function called by   */
+/* GC_call_with_world_stopped().                                        */
+GC_API void GC_CALL GC_free_objects_inner(void ** /* objects */,
+                                          size_t /* n */);
+
 #ifdef __cplusplus
   } /* end of extern "C" */
 #endif
@@ -1917,6 +1917,23 @@ GC_EXTERN GC_bool GC_print_back_height;
   GC_INNER void GC_dirty_init(void);
 #endif /* !GC_DISABLE_INCREMENTAL */
 
+/* Write tracking (see GC_track_writes) needs protection based dirty   */
+/* bits and a way of finding the stacks of the threads.                 */
+#if defined(MPROTECT_VDB) && !defined(GWW_VDB) && !defined(DARWIN) \
+    && !defined(GC_DISABLE_INCREMENTAL) && !defined(IA64) \
+    && (!defined(THREADS) || (defined(GC_PTHREADS) \
+                              && !defined(GC_WIN32_THREADS) \
+                              && !defined(GC_DARWIN_THREADS) \
+                              && !defined(GC_OPENBSD_THREADS)))
+# define WRITE_TRACKING
+# ifdef THREADS
+    GC_INNER void GC_scan_all_stacks(GC_scan_range_proc proc,
+                                     void *client_data);
+                        /* Call proc on the stack sections of all the   */
+                        /* threads, which are stopped but the caller.   */
+# endif
+#endif
+
 /* Slow/general mark bit manipulation: */
 GC_API_PRIV GC_bool GC_is_marked(ptr_t p);
 GC_INNER void GC_clear_mark_bit(ptr_t p);
@@ -495,6 +495,18 @@ GC_API void GC_CALL GC_free(void * p)
   }
 #endif /* THREADS */
 
+GC_API void GC_CALL GC_free_objects_inner(void ** objects, size_t n)
+{
+    size_t i;
+
+    GC_ASSERT(I_HOLD_LOCK());
+#   ifdef THREADS
+      for (i = 0; i < n; i++) GC_free_inner(objects[i]);
+#   else
+      for (i = 0; i < n; i++) GC_free(objects[i]);
+#   endif
+}
+
 #if defined(REDIRECT_MALLOC) && !defined(REDIRECT_FREE)
 # define REDIRECT_FREE GC_free
 #endif
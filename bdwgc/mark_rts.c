@@ -789,3 +789,41 @@ GC_INNER void GC_push_roots(GC_bool all, ptr_t cold_gc_frame)
         /* of stuff may have been pushed already, and this      */
         /* should be careful about mark stack overflows.        */
 }
+
+struct scan_roots_s {
+  GC_scan_range_proc proc;
+  void *client_data;
+};
+
+/*ARGSUSED*/
+STATIC void GC_scan_stacks_inner(ptr_t arg, void * context)
+{
+    struct scan_roots_s *s = (struct scan_roots_s *)arg;
+
+    /* Our callee-save registers are now on the stack, above the sp. */
+#   if defined(WRITE_TRACKING) && defined(THREADS)
+      GC_scan_all_stacks(s -> proc, s -> client_data);
+#   elif !defined(THREADS)
+#     ifdef STACK_GROWS_DOWN
+        s -> proc(GC_approx_sp(), GC_stackbottom, s -> client_data);
+#     else
+        s -> proc(GC_stackbottom, GC_approx_sp(), s -> client_data);
+#     endif
+#   endif
+}
+
+GC_API void GC_CALL GC_scan_roots(GC_scan_range_proc proc,
+                                  void *client_data)
+{
+    struct scan_roots_s s;
+    int i;
+
+    GC_ASSERT(I_HOLD_LOCK());
+    for (i = 0; i < n_root_sets; i++) {
+      proc(GC_static_roots[i].r_start, GC_static_roots[i].r_end,
+           client_data);
+    }
+    s.proc = proc;
+    s.client_data = client_data;
+    GC_with_callee_saves_pushed(GC_scan_stacks_inner, (ptr_t)&s);
+}
@@ -386,6 +386,14 @@ GC_API size_t GC_CALL GC_size(const void * p)
     return hhdr -> hb_sz;
 }
 
+GC_API int GC_CALL GC_get_kind_and_size(const void * p, size_t * psize)
+{
+    hdr * hhdr = HDR(p);
+
+    if (psize != NULL) *psize = hhdr -> hb_sz;
+    return hhdr -> hb_obj_kind;
+}
+
 GC_API size_t GC_CALL GC_get_heap_size(void)
 {
     size_t value;
@@ -3229,6 +3229,18 @@ STATIC void GC_protect_heap(void)
     }
 }
 
+#ifdef WRITE_TRACKING
+  STATIC page_hash_table GC_tracked_pages;
+                        /* Pages dirtied since the oldest pending call  */
+                        /* to GC_track_writes, saved from GC_dirty_pages */
+                        /* every time that it is cleared.               */
+  STATIC int GC_tracking_writes = 0;
+                        /* Number of pending calls to GC_track_writes.  */
+  STATIC page_hash_table GC_saved_dirty_pages;
+                        /* Dirty bits cleared by GC_clear_written_pages */
+                        /* which the collector has not read yet.        */
+#endif
+
 /* We assume that either the world is stopped or its OK to lose dirty   */
 /* bits while this is happenning (as in GC_enable_incremental).         */
 GC_INNER void GC_read_dirty(void)
@@ -3238,6 +3250,17 @@ GC_INNER void GC_read_dirty(void)
         GC_gww_read_dirty();
         return;
       }
+#   endif
+#   ifdef WRITE_TRACKING
+      {
+        unsigned i;
+        for (i = 0; i < PHT_SIZE; i++) {
+          if (GC_tracking_writes > 0)
+            GC_tracked_pages[i] |= GC_dirty_pages[i];
+          GC_dirty_pages[i] |= GC_saved_dirty_pages[i];
+        }
+        BZERO(GC_saved_dirty_pages, sizeof(GC_saved_dirty_pages));
+      }
 #   endif
     BCOPY((word *)GC_dirty_pages, GC_grungy_pages,
           (sizeof GC_dirty_pages));
@@ -4498,3 +4521,184 @@ void GC_print_address_map(void)
 }
 
 #endif
+
+#ifdef WRITE_TRACKING
+  GC_API int GC_CALL GC_track_writes(int on)
+  {
+    DCL_LOCK_STATE;
+
+    if (GC_find_leak) return 0;
+    LOCK();
+    if (!on) {
+      GC_ASSERT(GC_tracking_writes > 0);
+      GC_tracking_writes--;
+    } else {
+      if (!GC_dirty_maintained) {
+        /* As in GC_enable_incremental, but there is no need to collect */
+        /* first: the pages written before we protect the heap are      */
+        /* not the ones that we are asked about.                        */
+        GC_dirty_init();
+        if (!GC_dirty_maintained) {
+          UNLOCK();
+          return 0;
+        }
+        GC_read_dirty();
+      }
+      if (GC_tracking_writes++ == 0)
+        BZERO(GC_tracked_pages, sizeof(GC_tracked_pages));
+    }
+    UNLOCK();
+    return 1;
+  }
+
+  /* Call proc on the block h, skipping the objects of small object    */
+  /* blocks which the last collection found unreachable, if the block  */
+  /* was not swept since then: they still hold stale pointers.          */
+  STATIC void GC_scan_live_objects(struct hblk *h, hdr *hhdr,
+                                   GC_scan_range_proc proc,
+                                   void *client_data)
+  {
+    size_t sz = hhdr -> hb_sz;
+    size_t bit_no;
+    ptr_t p, plim;
+
+    if (sz > MAXOBJBYTES || GC_collection_in_progress()
+        || hhdr -> hb_last_reclaimed == (unsigned short)GC_gc_no) {
+      proc(h, h + 1, client_data);
+      return;
+    }
+    plim = h -> hb_body + HBLKSIZE - sz;
+    for (bit_no = 0, p = h -> hb_body; p <= plim;
+         bit_no += MARK_BIT_OFFSET(sz), p += sz) {
+      if (mark_bit_from_hdr(hhdr, bit_no))
+        proc(p, p + sz, client_data);
+    }
+  }
+
+  GC_API void GC_CALL GC_scan_written_pages(GC_scan_range_proc proc,
+                                            void *client_data)
+  {
+    unsigned i;
+
+    GC_ASSERT(I_HOLD_LOCK());
+    GC_ASSERT(GC_tracking_writes > 0);
+    for (i = 0; i < GC_n_heap_sects; i++) {
+      struct hblk * current = (struct hblk *)GC_heap_sects[i].hs_start;
+      struct hblk * limit = (struct hblk *)(GC_heap_sects[i].hs_start
+                                            + GC_heap_sects[i].hs_bytes);
+      while (current < limit) {
+        hdr * hhdr;
+        word nhblks;
+
+        GET_HDR(current, hhdr);
+        if (IS_FORWARDING_ADDR_OR_NIL(hhdr)) {
+          /* A block spanning heap segments, already scanned. */
+          current++;
+          continue;
+        }
+        if (HBLK_IS_FREE(hhdr)) {
+          nhblks = divHBLKSZ(hhdr -> hb_sz);
+        } else {
+          nhblks = OBJ_SZ_TO_BLOCKS(hhdr -> hb_sz);
+          if (!IS_PTRFREE(hhdr)) {
+            struct hblk * h;
+
+            for (h = current; h < current + nhblks; h++) {
+              word index = PHT_HASH(h);
+
+              if (get_pht_entry_from_index(GC_dirty_pages, index)
+                  || get_pht_entry_from_index(GC_tracked_pages, index))
+                {GC_scan_live_objects(h, hhdr, proc, client_data);}
+            }
+          }
+        }
+        current += nhblks;
+      }
+    }
+  }
+
+  /* Protect again the blocks which may contain pointers and whose      */
+  /* dirty bit is set.  The others are still protected, so that each    */
+  /* run of such blocks is protected at once, from its first dirty one  */
+  /* to its last one.                                                   */
+  STATIC void GC_protect_dirty_blocks(void)
+  {
+    unsigned i;
+
+    for (i = 0; i < GC_n_heap_sects; i++) {
+      struct hblk * current = (struct hblk *)GC_heap_sects[i].hs_start;
+      struct hblk * limit = (struct hblk *)(GC_heap_sects[i].hs_start
+                                            + GC_heap_sects[i].hs_bytes);
+      struct hblk * run_start = NULL, * run_end = NULL;
+
+      while (current < limit) {
+        hdr * hhdr;
+        word nhblks;
+
+        GET_HDR(current, hhdr);
+        if (IS_FORWARDING_ADDR_OR_NIL(hhdr) || HBLK_IS_FREE(hhdr)
+            || IS_PTRFREE(hhdr)) {
+          /* Not protected: this ends the run */
+          if (run_start != NULL) {
+            PROTECT(run_start, (ptr_t)run_end - (ptr_t)run_start);
+            run_start = NULL;
+          }
+          if (IS_FORWARDING_ADDR_OR_NIL(hhdr)) {
+            nhblks = 1;
+          } else if (HBLK_IS_FREE(hhdr)) {
+            nhblks = divHBLKSZ(hhdr -> hb_sz);
+          } else {
+            nhblks = OBJ_SZ_TO_BLOCKS(hhdr -> hb_sz);
+          }
+        } else {
+          struct hblk * h;
+
+          nhblks = OBJ_SZ_TO_BLOCKS(hhdr -> hb_sz);
+          for (h = current; h < current + nhblks; h++) {
+            if (get_pht_entry_from_index(GC_dirty_pages, PHT_HASH(h))) {
+              if (run_start == NULL) run_start = h;
+              run_end = h + 1;
+            }
+          }
+        }
+        current += nhblks;
+      }
+      if (run_start != NULL)
+        PROTECT(run_start, (ptr_t)run_end - (ptr_t)run_start);
+    }
+  }
+
+  GC_API void GC_CALL GC_clear_written_pages(void)
+  {
+    unsigned i;
+
+    GC_ASSERT(I_HOLD_LOCK());
+    if (GC_tracking_writes != 1) return;
+    if (GC_page_size != HBLKSIZE
+        || (GC_incremental_protection_needs() & GC_PROTECTS_PTRFREE_HEAP)) {
+      GC_protect_heap();
+    } else {
+      GC_protect_dirty_blocks();
+    }
+    for (i = 0; i < PHT_SIZE; i++)
+      GC_saved_dirty_pages[i] |= GC_dirty_pages[i];
+    BZERO((word *)GC_dirty_pages, sizeof(GC_dirty_pages));
+    BZERO(GC_tracked_pages, sizeof(GC_tracked_pages));
+  }
+#else
+  /*ARGSUSED*/
+  GC_API int GC_CALL GC_track_writes(int on)
+  {
+    return 0;
+  }
+
+  /*ARGSUSED*/
+  GC_API void GC_CALL GC_scan_written_pages(GC_scan_range_proc proc,
+                                            void *client_data)
+  {
+  }
+
+  GC_API void GC_CALL GC_clear_written_pages(void)
+  {
+  }
+#endif /* !WRITE_TRACKING */
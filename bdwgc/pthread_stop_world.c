@@ -353,6 +353,56 @@ GC_INNER void GC_push_all_stacks(void)
     GC_total_stacksize = total_size;
 }
 
+#ifdef WRITE_TRACKING
+  /* Like GC_push_all_stacks, but calling proc on the stacks instead of */
+  /* pushing them.  The world is stopped.                               */
+  GC_INNER void GC_scan_all_stacks(GC_scan_range_proc proc,
+                                   void *client_data)
+  {
+    int i;
+    GC_thread p;
+    ptr_t lo, hi;
+    struct GC_traced_stack_sect_s *traced_stack_sect;
+    pthread_t me = pthread_self();
+
+    for (i = 0; i < THREAD_TABLE_SZ; i++) {
+      for (p = GC_threads[i]; p != 0; p = p -> next) {
+        if (p -> flags & FINISHED) continue;
+        if (THREAD_EQUAL(p -> id, me)) {
+#           ifdef SPARC
+                lo = (ptr_t)GC_save_regs_in_stack();
+#           else
+                lo = GC_approx_sp();
+#           endif
+        } else {
+            lo = p -> stop_info.stack_ptr;
+        }
+        if ((p -> flags & MAIN_THREAD) == 0) {
+            hi = p -> stack_end;
+        } else {
+            hi = GC_stackbottom;
+        }
+        if (0 == lo) ABORT("GC_scan_all_stacks: sp not set!");
+        for (traced_stack_sect = p -> traced_stack_sect;
+             traced_stack_sect != NULL;
+             traced_stack_sect = traced_stack_sect -> prev) {
+#           ifdef STACK_GROWS_UP
+              proc((ptr_t)traced_stack_sect, lo, client_data);
+#           else
+              proc(lo, (ptr_t)traced_stack_sect, client_data);
+#           endif
+            lo = traced_stack_sect -> saved_stack_ptr;
+        }
+#       ifdef STACK_GROWS_UP
+          proc(hi, lo, client_data);
+#       else
+          proc(lo, hi, client_data);
+#       endif
+      }
+    }
+  }
+#endif /* WRITE_TRACKING */
+
 /* There seems to be a very rare thread stopping problem.  To help us  */
 /* debug that, we save the ids of the stopping thread. */
 #ifdef DEBUG_THREADS
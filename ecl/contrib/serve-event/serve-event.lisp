@@ -2,11 +2,28 @@
 ;;
 ;; This file provides a port the SBCL/CMUCL 'serve-event'
 ;; functionality to ecl.  serve-event provides a lispy abstraction of
-;; unix select(2) non-blocking IO (and potentially other variants such as
-;; epoll).  It works with Unix-level file-descriptors, which can be
+;; unix non-blocking IO, using epoll(7) on Linux and select(2)
+;; elsewhere.  It works with Unix-level file-descriptors, which can be
 ;; retrieved from the sockets module using the socket-file-descriptor
 ;; slot.
 ;;
+;; Handlers are kept in a hash table indexed by descriptor.  With
+;; epoll, each descriptor is registered with the kernel when its first
+;; handler is added and dropped with its last one, so that the cost of
+;; SERVE-EVENT only depends on the number of descriptors that are
+;; ready, and there is no limit on the value of the descriptors.  The
+;; select(2) version rebuilds its sets on every call and only accepts
+;; descriptors below FD_SETSIZE.
+;;
+;; Handlers are level-triggered by default: they are called as long as
+;; the descriptor is ready.  With :TRIGGER :EDGE they are only called
+;; when it becomes ready, and must then read or write until it would
+;; block.  A descriptor is edge-triggered when all its handlers are,
+;; and with select(2) all of them are level-triggered.
+;;
+;; Timers created with ADD-TIMER run from SERVE-EVENT, which does not
+;; wait past the deadline of the next one.
+;;
 ;; As this file is based on SBCL's serve-event module it is being
 ;; released under the same (non) license as SBCL (i.e. public-domain).
 ;;
@@ -37,12 +54,15 @@
 (defpackage "SERVE-EVENT"
   (:use "CL" "FFI" "UFFI")
   (:export "WITH-FD-HANDLER" "ADD-FD-HANDLER" "REMOVE-FD-HANDLER"
-           "SERVE-EVENT" "SERVE-ALL-EVENTS"))
+           "SERVE-EVENT" "SERVE-ALL-EVENTS"
+           "ADD-TIMER" "REMOVE-TIMER"))
 (in-package "SERVE-EVENT")
 
 (clines
  "#include <errno.h>"
- "#include <sys/select.h>")
+ #+linux "#include <sys/epoll.h>"
+ #+linux "#define MAX_EVENTS 256"
+ #-linux "#include <sys/select.h>")
 
 (eval-when (:compile-toplevel :execute)
   (defmacro c-constant (c-name)
@@ -56,86 +76,321 @@
 (define-c-constants
     +eintr+ "EINTR")
 
+;;; Maximum number of ready descriptors taken from the kernel at once
+#+linux
+(define-c-constants
+    +max-events+ "MAX_EVENTS")
+
+;;; Handlers and timers are named vectors and not structure classes,
+;;; because the module is compiled by the bootstrap image, which has
+;;; no CLOS to define those classes with.
 (defstruct (handler
-            (:constructor make-handler (direction descriptor function))
+            (:type vector) :named
+            (:constructor make-handler (direction descriptor function trigger))
             (:copier nil))
   ;; Reading or writing...
   (direction nil :type (member :input :output))
   ;; File descriptor this handler is tied to.
-  ;; FIXME: Should be based on FD_SETSIZE
-  (descriptor 0)
+  (descriptor 0 :type fixnum)
   ;; Function to call.
-  (function nil :type function))
+  (function nil :type function)
+  ;; Called while the descriptor is ready, or when it becomes ready
+  (trigger :level :type (member :level :edge)))
+
+
+(defvar *descriptor-handlers* (make-hash-table :test 'eql)
+  "Table of the currently active handlers, indexed by file descriptor.")
+
+(defvar *epoll-fd* nil
+  "Descriptor of the epoll instance, created by the first handler.")
+
 
+;;; The kernel interface. Each descriptor is registered for the union of
+;;; the directions of its handlers.
+#+linux
+(defun epoll-fd ()
+  (or *epoll-fd*
+      (multiple-value-bind (fd errno)
+          (c-inline () () (values :int :int)
+                    "{ @(return 0) = epoll_create1(EPOLL_CLOEXEC);
+                       @(return 1) = errno; }"
+                    :one-liner nil
+                    :side-effects t)
+        (when (minusp fd)
+          (error "Cannot create an epoll instance, errno ~D" errno))
+        (setf *epoll-fd* fd))))
 
-(defvar *descriptor-handlers* nil
-  #!+sb-doc
-  "List of all the currently active handlers for file descriptors")
+#+linux
+(defun update-descriptor (fd old-handlers new-handlers)
+  (let ((input (if (find :input new-handlers :key #'handler-direction) 1 0))
+        (output (if (find :output new-handlers :key #'handler-direction) 1 0))
+        (edge (if (every #'(lambda (h) (eq (handler-trigger h) :edge))
+                         new-handlers)
+                  1 0))
+        (op (cond ((null new-handlers) 2)
+                  ((null old-handlers) 0)
+                  (t 1))))
+    (multiple-value-bind (retval errno)
+        (c-inline ((epoll-fd) op fd input output edge)
+                  (:int :int :int :int :int :int) (values :int :int)
+                  "{ static const int ops[] = { EPOLL_CTL_ADD, EPOLL_CTL_MOD,
+                                                EPOLL_CTL_DEL };
+                     struct epoll_event ev;
+                     int op = ops[#1];
+                     ev.events = (#3? EPOLLIN : 0) | (#4? EPOLLOUT : 0) |
+                                 (#5? EPOLLET : 0);
+                     ev.data.u64 = 0;
+                     ev.data.fd = #2;
+                     @(return 0) = epoll_ctl(#0, op, #2, &ev);
+                     /* The descriptor was closed and reused without
+                        removing its handlers: a closed descriptor has
+                        left the epoll set, a duplicate may still be in */
+                     if (@(return 0) < 0 && op == EPOLL_CTL_ADD && errno == EEXIST)
+                             @(return 0) = epoll_ctl(#0, EPOLL_CTL_MOD, #2, &ev);
+                     else if (@(return 0) < 0 && op == EPOLL_CTL_MOD && errno == ENOENT)
+                             @(return 0) = epoll_ctl(#0, EPOLL_CTL_ADD, #2, &ev);
+                     @(return 1) = errno; }"
+                  :one-liner nil
+                  :side-effects t)
+      ;; A closed descriptor has already left the epoll set
+      (when (and (minusp retval) new-handlers)
+        (error "Cannot watch file descriptor ~D, errno ~D" fd errno)))))
+
+#-linux
+(defun update-descriptor (fd old-handlers new-handlers)
+  (declare (ignore old-handlers new-handlers))
+  (unless (< -1 fd (c-inline () () :int "FD_SETSIZE" :one-liner t))
+    (error "File descriptor ~D is out of the range of select()" fd)))
 
 
 ;;; Add a new handler to *descriptor-handlers*.
-(defun add-fd-handler (fd direction function)
+(defun add-fd-handler (fd direction function &key (trigger :level))
   "Arrange to call FUNCTION whenever FD is usable. DIRECTION should be
-  either :INPUT or :OUTPUT. The value returned should be passed to
-  SYSTEM:REMOVE-FD-HANDLER when it is no longer needed."
+  either :INPUT or :OUTPUT. TRIGGER is :LEVEL, to call FUNCTION as long
+  as FD is usable, or :EDGE, to call it only when FD becomes usable. The
+  value returned should be passed to SYSTEM:REMOVE-FD-HANDLER when it is
+  no longer needed."
   (unless (member direction '(:input :output))
     ;; FIXME: should be TYPE-ERROR?
     (error "Invalid direction ~S, must be either :INPUT or :OUTPUT" direction))
-  (let ((handler (make-handler direction fd function)))
-    (push handler *descriptor-handlers*)
+  (unless (member trigger '(:level :edge))
+    (error "Invalid trigger ~S, must be either :LEVEL or :EDGE" trigger))
+  (let* ((handler (make-handler direction fd function trigger))
+         (old (gethash fd *descriptor-handlers*))
+         (new (cons handler old)))
+    (update-descriptor fd old new)
+    (setf (gethash fd *descriptor-handlers*) new)
     handler))
 
 ;;; Remove an old handler from *descriptor-handlers*.
 (defun remove-fd-handler (handler)
-  #!+sb-doc
   "Removes HANDLER from the list of active handlers."
-  (setf *descriptor-handlers*
-        (delete handler *descriptor-handlers*)))
+  (let* ((fd (handler-descriptor handler))
+         (old (gethash fd *descriptor-handlers*))
+         (new (remove handler old)))
+    (unless (eq old new)
+      (if new
+          (setf (gethash fd *descriptor-handlers*) new)
+          (remhash fd *descriptor-handlers*))
+      (update-descriptor fd old new))))
 
 ;;; Add the handler to *descriptor-handlers* for the duration of BODY.
-(defmacro with-fd-handler ((fd direction function) &rest body)
+(defmacro with-fd-handler ((fd direction function &rest options) &rest body)
   "Establish a handler with SYSTEM:ADD-FD-HANDLER for the duration of BODY.
    DIRECTION should be either :INPUT or :OUTPUT, FD is the file descriptor to
-   use, and FUNCTION is the function to call whenever FD is usable."
+   use, and FUNCTION is the function to call whenever FD is usable. OPTIONS
+   are passed to ADD-FD-HANDLER."
   (let ((handler (gensym)))
     `(let (,handler)
        (unwind-protect
            (progn
-             (setf ,handler (add-fd-handler ,fd ,direction ,function))
+             (setf ,handler (add-fd-handler ,fd ,direction ,function ,@options))
              ,@body)
          (when ,handler
            (remove-fd-handler ,handler))))))
 
 
+;;; Timers are kept in a binary heap ordered by deadline, in internal
+;;; time units. Removed timers stay in the heap until they expire.
+(defstruct (timer
+            (:type vector) :named
+            (:constructor make-timer (deadline function interval))
+            (:copier nil))
+  (deadline 0 :type integer)
+  (function nil :type (or null function))
+  (interval nil))
+
+(defvar *timers* (make-array 16 :adjustable t :fill-pointer 0)
+  "Heap of pending timers, the earliest one first.")
+
+(defun seconds-to-internal-time (seconds)
+  (ceiling (* seconds internal-time-units-per-second)))
+
+(defun heap-insert (timer)
+  (let ((heap *timers*))
+    (vector-push-extend timer heap)
+    (do ((i (1- (fill-pointer heap)) parent)
+         (parent 0))
+        ((zerop i))
+      (setf parent (floor (1- i) 2))
+      (when (<= (timer-deadline (aref heap parent)) (timer-deadline timer))
+        (return))
+      (rotatef (aref heap i) (aref heap parent)))))
+
+(defun heap-pop ()
+  (let* ((heap *timers*)
+         (top (aref heap 0))
+         (last (vector-pop heap))
+         (n (fill-pointer heap)))
+    (when (plusp n)
+      (setf (aref heap 0) last)
+      (do ((i 0)) (nil)
+        (let* ((left (1+ (* 2 i)))
+               (right (1+ left))
+               (min i))
+          (when (and (< left n)
+                     (< (timer-deadline (aref heap left))
+                        (timer-deadline (aref heap min))))
+            (setf min left))
+          (when (and (< right n)
+                     (< (timer-deadline (aref heap right))
+                        (timer-deadline (aref heap min))))
+            (setf min right))
+          (when (= min i)
+            (return))
+          (rotatef (aref heap i) (aref heap min))
+          (setf i min))))
+    top))
+
+(defun add-timer (seconds function &key repeat)
+  "Arrange to call FUNCTION, without arguments, from SERVE-EVENT once
+  SECONDS have elapsed, and then every SECONDS if REPEAT is true. The
+  value returned may be passed to REMOVE-TIMER."
+  (let ((timer (make-timer (+ (get-internal-real-time)
+                              (seconds-to-internal-time seconds))
+                           function
+                           (and repeat (max 1 (seconds-to-internal-time seconds))))))
+    (heap-insert timer)
+    timer))
+
+(defun remove-timer (timer)
+  "Cancels TIMER, so that its function is not called again."
+  (setf (timer-function timer) nil
+        (timer-interval timer) nil))
+
+(defun run-timers ()
+  "Calls the functions of the expired timers. Returns T if there was one."
+  (let ((now (get-internal-real-time))
+        (heap *timers*)
+        (ran nil))
+    (loop while (and (plusp (fill-pointer heap))
+                     (<= (timer-deadline (aref heap 0)) now))
+          do (let* ((timer (heap-pop))
+                    (function (timer-function timer)))
+               (when function
+                 (when (timer-interval timer)
+                   ;; Calls missed by a late SERVE-EVENT are skipped
+                   (setf (timer-deadline timer)
+                         (+ (max (timer-deadline timer) now)
+                            (timer-interval timer)))
+                   (heap-insert timer))
+                 (setf ran t)
+                 (funcall function))))
+    ran))
+
+(defun wait-milliseconds (seconds)
+  "How long SERVE-EVENT may block, -1 meaning forever."
+  (let ((wait (and seconds (seconds-to-internal-time seconds))))
+    ;; Cancelled timers do not shorten the wait
+    (loop while (and (plusp (fill-pointer *timers*))
+                     (null (timer-function (aref *timers* 0))))
+          do (heap-pop))
+    (when (plusp (fill-pointer *timers*))
+      (let ((left (max 0 (- (timer-deadline (aref *timers* 0))
+                            (get-internal-real-time)))))
+        (setf wait (if wait (min wait left) left))))
+    (if wait
+        (min (ceiling (* wait 1000) internal-time-units-per-second)
+             #x7FFFFFFF)
+        -1)))
+
+
+(defun dispatch (fd readable writable)
+  (dolist (handler (gethash fd *descriptor-handlers*))
+    (when (if (eq (handler-direction handler) :input) readable writable)
+      (funcall (handler-function handler) fd))))
+
+#+linux
+(defvar *event-vectors* nil
+  "Vectors of descriptors and of their readiness, for epoll_wait(), while
+they are not in use.")
+
+#+linux
+(defun wait-for-events (milliseconds)
+  ;; The vectors are reused from call to call. A handler which calls
+  ;; SERVE-EVENT recursively finds them taken and gets new ones.
+  (let* ((vectors (or (shiftf *event-vectors* nil)
+                      (cons (make-array +max-events+ :element-type 'fixnum)
+                            (make-array +max-events+ :element-type 'fixnum))))
+         (fds (car vectors))
+         (flags (cdr vectors)))
+    (unwind-protect
+         (multiple-value-bind (retval errno)
+             (c-inline ((epoll-fd) fds flags milliseconds)
+                       (:int :object :object :int) (values :int :int)
+                       "{ struct epoll_event ev[MAX_EVENTS];
+                          int i, n = epoll_wait(#0, ev, MAX_EVENTS, #3);
+                          @(return 1) = errno;
+                          for (i = 0; i < n; i++) {
+                                  int e = ev[i].events;
+                                  #1->vector.self.fix[i] = ev[i].data.fd;
+                                  #2->vector.self.fix[i] =
+                                          ((e & (EPOLLIN|EPOLLHUP|EPOLLERR))? 1 : 0) |
+                                          ((e & (EPOLLOUT|EPOLLHUP|EPOLLERR))? 2 : 0);
+                          }
+                          @(return 0) = n; }"
+                       :one-liner nil
+                       :side-effects t)
+           (cond ((minusp retval)
+                  (if (= errno +eintr+)
+                      ;; suppress EINTR
+                      nil
+                      ;; otherwise error
+                      (error "Error during epoll_wait, errno ~D" errno)))
+                 (t
+                  (dotimes (i retval)
+                    (let ((flag (aref flags i)))
+                      (dispatch (aref fds i) (logtest flag 1) (logtest flag 2))))
+                  (plusp retval))))
+      (setf *event-vectors* vectors))))
+
+#-linux
 (defmacro fd-zero(fdset)
   `(c-inline (,fdset) (:object) :void 
              "FD_ZERO((fd_set*)#0->foreign.data)"
              :one-liner t
              :side-effects t))
 
+#-linux
 (defmacro fd-set (fd fdset)
   `(c-inline (,fd ,fdset) (:int :object) :void 
              "FD_SET(#0, (fd_set*)#1->foreign.data);"
              :one-liner t
              :side-effects t))
 
+#-linux
 (defmacro fd-isset (fd fdset)
   `(c-inline (,fd ,fdset) (:int :object) :int 
              "FD_ISSET(#0, (fd_set*)#1->foreign.data)"
              :one-liner t
              :side-effects t))
 
+#-linux
 (defun fdset-size ()
   (c-inline () () :int "sizeof(fd_set)" :one-liner t :side-effects nil))
 
-
-(defun serve-event (&optional (seconds nil))
-  "Receive pending events on all FD-STREAMS and dispatch to the appropriate
-   handler functions. If timeout is specified, server will wait the specified
-   time (in seconds) and then return, otherwise it will wait until something
-   happens. Server returns T if something happened and NIL otherwise. Timeout
-   0 means polling without waiting."
-
+#-linux
+(defun wait-for-events (milliseconds)
   ;; fd_set is an opaque typedef, so we can't declare it locally.
   ;; However we can fine out its size and allocate a char array of
   ;; the same size which can be used in its place.
@@ -147,54 +402,61 @@
 
       (let ((maxfd 0))
         ;; Load the descriptors into the relevant set
-        (dolist (handler *descriptor-handlers*)
-          (let ((fd (handler-descriptor handler)))
-            (ecase (handler-direction handler)
-              (:input (fd-set fd rfd))
-              (:output (fd-set fd wfd)))
-            (when (> fd maxfd)
-          (setf maxfd fd))))
+        (maphash #'(lambda (fd handlers)
+                     (dolist (handler handlers)
+                       (ecase (handler-direction handler)
+                         (:input (fd-set fd rfd))
+                         (:output (fd-set fd wfd))))
+                     (when (> fd maxfd)
+                       (setf maxfd fd)))
+                 *descriptor-handlers*)
 
         (multiple-value-bind (retval errno)
-	    (if (null seconds)
-		;; No timeout
-		(c-inline (rfd      wfd    (1+ maxfd))
-			  (:object :object :int) (values :int :int)
-			  "{ @(return 0) = select(#2, (fd_set*)#0->foreign.data,
-                                                      (fd_set*)#1->foreign.data,
-                                                      NULL, NULL);
-                             @(return 1) = errno; }"
-			  :one-liner nil
-			  :side-effects t)
-		(c-inline (rfd      wfd    (1+ maxfd) seconds) 
-			  (:object :object :int       :int) (values :int :int)
-			  "{ struct timeval tv;
-                                tv.tv_sec = #3;
-                                tv.tv_usec = 0;
-                                @(return 0) = select(#2, (fd_set*)#0->foreign.data,
-                                                         (fd_set*)#1->foreign.data,
-                                                         NULL, &tv);
-                                @(return 1) = errno; }"
-			  :one-liner nil
-			  :side-effects t))
-
-	  (cond ((zerop retval) 
-		 nil)
-		((minusp retval)
-		 (if (= errno +eintr+)
-		     ;; suppress EINTR
-		     nil
-		     ;; otherwise error
-		     (error "Error during select")))
-		((plusp retval)  
-		 (dolist (handler *descriptor-handlers*)
-		   (let ((fd (handler-descriptor handler)))
-		     (if (plusp (ecase (handler-direction handler)
-				  (:input (fd-isset fd rfd))
-				  (:output (fd-isset fd wfd))))
-			 (funcall (handler-function handler) 
-				  (handler-descriptor handler)))))
-		 t)))))))
+            (c-inline (rfd      wfd    (1+ maxfd) milliseconds)
+                      (:object :object :int       :int) (values :int :int)
+                      "{ struct timeval tv;
+                         tv.tv_sec = #3 / 1000;
+                         tv.tv_usec = (#3 % 1000) * 1000;
+                         @(return 0) = select(#2, (fd_set*)#0->foreign.data,
+                                                  (fd_set*)#1->foreign.data,
+                                                  NULL, (#3 < 0)? NULL : &tv);
+                         @(return 1) = errno; }"
+                      :one-liner nil
+                      :side-effects t)
+
+          (cond ((zerop retval) 
+                 nil)
+                ((minusp retval)
+                 (if (= errno +eintr+)
+                     ;; suppress EINTR
+                     nil
+                     ;; otherwise error
+                     (error "Error during select")))
+                ((plusp retval)
+                 (let (ready)
+                   (maphash #'(lambda (fd handlers)
+                                (declare (ignore handlers))
+                                (let ((readable (plusp (fd-isset fd rfd)))
+                                      (writable (plusp (fd-isset fd wfd))))
+                                  (when (or readable writable)
+                                    (push (list fd readable writable) ready))))
+                            *descriptor-handlers*)
+                   ;; Handlers may add or remove others
+                   (loop for args in ready
+                         do (apply #'dispatch args)))
+                 t)))))))
+
+
+(defun serve-event (&optional (seconds nil))
+  "Receive pending events on all FD-STREAMS and dispatch to the appropriate
+   handler functions, and run the timers which have expired. If timeout is
+   specified, server will wait the specified time (in seconds) and then
+   return, otherwise it will wait until something happens. Server returns T
+   if something happened and NIL otherwise. Timeout 0 means polling without
+   waiting."
+  (let ((events (wait-for-events (wait-milliseconds seconds)))
+        (timers (run-timers)))
+    (or events timers)))
 
 
 ;;; Wait for up to timeout seconds for an event to happen. Make sure all
@@ -21,4 +21,6 @@
 	   "SOCKET-FAMILY" "SOCKET-PROTOCOL" "SOCKET-TYPE"
 	   "SOCKET-ERROR" "NAME-SERVICE-ERROR" "NON-BLOCKING-MODE"
 	   "HOST-ENT-NAME" "HOST-ENT-ALIASES" "HOST-ENT-ADDRESS-TYPE"
-	   "HOST-ENT-ADDRESSES" "HOST-ENT" "HOST-ENT-ADDRESS" "SOCKET-SEND"))
+	   "HOST-ENT-ADDRESSES" "HOST-ENT" "HOST-ENT-ADDRESS" "SOCKET-SEND"
+	   "SOCKET-RECEIVE-OCTETS" "SOCKET-SEND-OCTETS"
+	   "SOCKET-RECEIVE-BATCH" "SOCKET-SEND-BATCH"))
@@ -773,6 +773,339 @@ static void fill_inet_sockaddr(struct sockaddr_in *sockaddr, int port,
 	  (socket-error "send")
 	  len-sent))))
 
+;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;
+;;;
+;;; SENDING AND RECEIVING INTO OCTET VECTORS
+;;;
+;;; These functions are not generic and take the socket or its file
+;;; descriptor, the data goes to and from vectors supplied by the
+;;; caller, and nothing is allocated unless an error is signalled. The
+;;; batched ones use recvmmsg() and sendmmsg() where available, moving
+;;; up to SOCKET_BATCH messages per system call.
+;;;
+
+(Clines
+ "#if defined(__linux__) && defined(MSG_WAITFORONE)"
+ "#define HAVE_MMSG"
+ "#define SOCKET_BATCH 64"
+ "#endif"
+ "
+static char *
+octet_buffer(cl_object x, cl_index start, cl_index end)
+{
+	if (type_of(x) != t_vector ||
+	    (x->vector.elttype != aet_b8 && x->vector.elttype != aet_i8)) {
+		FEerror(\"Lisp object is not a vector of octets: ~A\", 1, x);
+	}
+	if (start > end || end > x->vector.dim) {
+		FEerror(\"Wrong interval [~D, ~D) for socket buffer ~A\", 3,
+			MAKE_FIXNUM(start), MAKE_FIXNUM(end), x);
+	}
+	return (char *)x->vector.self.b8 + start;
+}
+
+static int
+store_inet_address(cl_object address, cl_object ports, cl_index i,
+		   struct sockaddr_in *name)
+{
+	uint32_t ip = ntohl(name->sin_addr.s_addr);
+	uint16_t port = ntohs(name->sin_port);
+	if (name->sin_family != AF_INET)
+		return 0;
+	if (address != Cnil) {
+		ecl_aset1(address, 0, MAKE_FIXNUM(ip >> 24));
+		ecl_aset1(address, 1, MAKE_FIXNUM((ip >> 16) & 0xFF));
+		ecl_aset1(address, 2, MAKE_FIXNUM((ip >> 8) & 0xFF));
+		ecl_aset1(address, 3, MAKE_FIXNUM(ip & 0xFF));
+	}
+	if (ports != Cnil)
+		ecl_aset1(ports, i, MAKE_FIXNUM(port));
+	return port;
+}
+
+static void
+load_inet_address(struct sockaddr_in *name, cl_object address, cl_object port)
+{
+	fill_inet_sockaddr(name, fixint(port),
+			   fixint(ecl_aref1(address, 0)), fixint(ecl_aref1(address, 1)),
+			   fixint(ecl_aref1(address, 2)), fixint(ecl_aref1(address, 3)));
+}
+")
+
+(defmacro with-socket-descriptor ((fd socket) &body body)
+  `(let ((,fd (if (integerp ,socket) ,socket (socket-file-descriptor ,socket))))
+     ,@body))
+
+(defun socket-receive-octets (socket buffer &key (start 0) end address
+                              oob peek waitall dontwait)
+  "Receives a message into BUFFER, a vector of octets, between START and
+END, without allocating memory. SOCKET is a socket or its file
+descriptor. When ADDRESS, a vector of four elements, is supplied, the IPv4
+address of the sender is stored in it. Returns the number of octets
+received and the port of the sender, or NIL when no message could be
+received without blocking or the call was interrupted."
+  (with-socket-descriptor (fd socket)
+    (multiple-value-bind (len-recv port errno)
+        (c-inline (fd buffer start (or end (length buffer)) address
+                   oob peek waitall dontwait)
+                  (:int :object :fixnum :fixnum :object :bool :bool :bool :bool)
+                  (values :long :int :int)
+                  "
+{
+        int flags = ( #5 ? MSG_OOB : 0 )  |
+                    ( #6 ? MSG_PEEK : 0 ) |
+                    ( #7 ? MSG_WAITALL : 0 ) |
+                    ( #8 ? MSG_DONTWAIT : 0 );
+        char *data = octet_buffer(#1, #2, #3);
+        struct sockaddr_in name;
+        socklen_t name_len = sizeof(struct sockaddr_in);
+        ssize_t len;
+
+        name.sin_family = AF_UNSPEC;
+        ecl_disable_interrupts();
+        len = recvfrom(#0, data, #3 - #2, flags,
+                       (struct sockaddr*)&name, &name_len);
+        @(return 2) = errno;
+        ecl_enable_interrupts();
+        @(return 0) = len;
+        @(return 1) = (len >= 0)? store_inet_address(#4, Cnil, 0, &name) : 0;
+}
+"
+                  :one-liner nil)
+      (cond ((>= len-recv 0)
+             (values len-recv port))
+            ((or (= errno +eagain+) (= errno +eintr+))
+             nil)
+            (t
+             (socket-error "receive"))))))
+
+(defun socket-send-octets (socket buffer &key (start 0) end address port
+                           oob eor dontroute dontwait nosignal confirm)
+  "Sends the octets of BUFFER between START and END, without allocating
+memory. SOCKET is a socket or its file descriptor. ADDRESS, a vector of
+four octets, and PORT give the destination of unconnected sockets.
+Returns the number of octets sent, or NIL when they could not be sent
+without blocking or the call was interrupted."
+  (with-socket-descriptor (fd socket)
+    (multiple-value-bind (len-sent errno)
+        (c-inline (fd buffer start (or end (length buffer)) address port
+                   oob eor dontroute dontwait nosignal confirm)
+                  (:int :object :fixnum :fixnum :object :object
+                   :bool :bool :bool :bool :bool :bool)
+                  (values :long :int)
+                  "
+{
+        int flags = ( #6 ? MSG_OOB : 0 )  |
+                    ( #7 ? MSG_EOR : 0 ) |
+                    ( #8 ? MSG_DONTROUTE : 0 ) |
+                    ( #9 ? MSG_DONTWAIT : 0 ) |
+                    ( #a ? MSG_NOSIGNAL : 0 ) |
+                    ( #b ? MSG_CONFIRM : 0 );
+        char *data = octet_buffer(#1, #2, #3);
+        struct sockaddr_in name;
+        ssize_t len;
+
+        if (#4 != Cnil)
+                load_inet_address(&name, #4, #5);
+        ecl_disable_interrupts();
+        if (#4 != Cnil)
+                len = sendto(#0, data, #3 - #2, flags,
+                             (struct sockaddr*)&name, sizeof(struct sockaddr_in));
+        else
+                len = send(#0, data, #3 - #2, flags);
+        @(return 1) = errno;
+        ecl_enable_interrupts();
+        @(return 0) = len;
+}
+"
+                  :one-liner nil)
+      (cond ((>= len-sent 0)
+             len-sent)
+            ((or (= errno +eagain+) (= errno +eintr+))
+             nil)
+            (t
+             (socket-error "send"))))))
+
+(defun socket-receive-batch (socket buffers lengths
+                             &key (count (length buffers)) addresses ports
+                             dontwait)
+  "Receives up to COUNT messages, the I-th one into the I-th vector of
+octets in BUFFERS, storing its length in the I-th element of LENGTHS and,
+when supplied, the address and port of its sender in the I-th vector of
+ADDRESSES and the I-th element of PORTS. Only the first message is waited
+for. SOCKET is a socket or its file descriptor. Returns the number of
+messages received, or NIL when none could be received without blocking or
+the call was interrupted. Nothing is allocated."
+  (with-socket-descriptor (fd socket)
+    (multiple-value-bind (received errno)
+        (c-inline (fd buffers lengths count addresses ports dontwait)
+                  (:int :object :object :fixnum :object :object :bool)
+                  (values :fixnum :int)
+                  "
+{
+        cl_index i, n = #3, done = 0;
+        int flags = #6 ? MSG_DONTWAIT : 0;
+        int error = 0;
+#ifdef HAVE_MMSG
+        struct mmsghdr messages[SOCKET_BATCH];
+        struct iovec data[SOCKET_BATCH];
+        struct sockaddr_in names[SOCKET_BATCH];
+        while (done < n) {
+                cl_index m = n - done;
+                int got;
+                if (m > SOCKET_BATCH) m = SOCKET_BATCH;
+                for (i = 0; i < m; i++) {
+                        cl_object buffer = ecl_aref1(#1, done + i);
+                        cl_index size = ecl_length(buffer);
+                        data[i].iov_base = octet_buffer(buffer, 0, size);
+                        data[i].iov_len = size;
+                        memset(&messages[i].msg_hdr, 0, sizeof(struct msghdr));
+                        messages[i].msg_hdr.msg_iov = data + i;
+                        messages[i].msg_hdr.msg_iovlen = 1;
+                        messages[i].msg_hdr.msg_name = names + i;
+                        messages[i].msg_hdr.msg_namelen = sizeof(struct sockaddr_in);
+                        names[i].sin_family = AF_UNSPEC;
+                }
+                ecl_disable_interrupts();
+                got = recvmmsg(#0, messages, m, flags | MSG_WAITFORONE, NULL);
+                if (got < 0) error = errno;
+                ecl_enable_interrupts();
+                if (got < 0)
+                        break;
+                for (i = 0; i < got; i++) {
+                        ecl_aset1(#2, done + i, MAKE_FIXNUM(messages[i].msg_len));
+                        store_inet_address((#4 == Cnil)? Cnil : ecl_aref1(#4, done + i),
+                                           #5, done + i, names + i);
+                }
+                done += got;
+                if (got < (int)m)
+                        break;
+                flags |= MSG_DONTWAIT;
+        }
+#else
+        for (; done < n; done++) {
+                cl_object buffer = ecl_aref1(#1, done);
+                cl_index size = ecl_length(buffer);
+                char *data = octet_buffer(buffer, 0, size);
+                struct sockaddr_in name;
+                socklen_t name_len = sizeof(struct sockaddr_in);
+                ssize_t len;
+                name.sin_family = AF_UNSPEC;
+                ecl_disable_interrupts();
+                len = recvfrom(#0, data, size, flags,
+                               (struct sockaddr*)&name, &name_len);
+                if (len < 0) error = errno;
+                ecl_enable_interrupts();
+                if (len < 0)
+                        break;
+                ecl_aset1(#2, done, MAKE_FIXNUM(len));
+                store_inet_address((#4 == Cnil)? Cnil : ecl_aref1(#4, done),
+                                   #5, done, &name);
+                flags |= MSG_DONTWAIT;
+        }
+#endif
+        @(return 0) = (done == 0 && error)? -1 : done;
+        @(return 1) = error;
+}
+"
+                  :one-liner nil)
+      (cond ((>= received 0)
+             received)
+            ((or (= errno +eagain+) (= errno +eintr+))
+             nil)
+            (t
+             (socket-error "receive"))))))
+
+(defun socket-send-batch (socket buffers
+                          &key (count (length buffers)) lengths addresses ports
+                          dontwait nosignal)
+  "Sends COUNT messages, the I-th one made of the first octets of the I-th
+vector in BUFFERS, as many as the I-th element of LENGTHS or all of them,
+to the address in the I-th vector of ADDRESSES and the port in the I-th
+element of PORTS, when these are supplied. SOCKET is a socket or its file
+descriptor. Returns the number of messages sent, or NIL when none could be
+sent without blocking or the call was interrupted. Nothing is allocated."
+  (with-socket-descriptor (fd socket)
+    (multiple-value-bind (sent errno)
+        (c-inline (fd buffers count lengths addresses ports dontwait nosignal)
+                  (:int :object :fixnum :object :object :object :bool :bool)
+                  (values :fixnum :int)
+                  "
+{
+        cl_index i, n = #2, done = 0;
+        int flags = ( #6 ? MSG_DONTWAIT : 0 ) |
+                    ( #7 ? MSG_NOSIGNAL : 0 );
+        int error = 0;
+#ifdef HAVE_MMSG
+        struct mmsghdr messages[SOCKET_BATCH];
+        struct iovec data[SOCKET_BATCH];
+        struct sockaddr_in names[SOCKET_BATCH];
+        while (done < n) {
+                cl_index m = n - done;
+                int got;
+                if (m > SOCKET_BATCH) m = SOCKET_BATCH;
+                for (i = 0; i < m; i++) {
+                        cl_object buffer = ecl_aref1(#1, done + i);
+                        cl_index size = (#3 == Cnil)? ecl_length(buffer) :
+                                fixnnint(ecl_aref1(#3, done + i));
+                        data[i].iov_base = octet_buffer(buffer, 0, size);
+                        data[i].iov_len = size;
+                        memset(&messages[i].msg_hdr, 0, sizeof(struct msghdr));
+                        messages[i].msg_hdr.msg_iov = data + i;
+                        messages[i].msg_hdr.msg_iovlen = 1;
+                        if (#4 != Cnil) {
+                                load_inet_address(names + i, ecl_aref1(#4, done + i),
+                                                  ecl_aref1(#5, done + i));
+                                messages[i].msg_hdr.msg_name = names + i;
+                                messages[i].msg_hdr.msg_namelen = sizeof(struct sockaddr_in);
+                        }
+                }
+                ecl_disable_interrupts();
+                got = sendmmsg(#0, messages, m, flags);
+                if (got < 0) error = errno;
+                ecl_enable_interrupts();
+                if (got < 0)
+                        break;
+                done += got;
+                if (got < (int)m)
+                        break;
+        }
+#else
+        for (; done < n; done++) {
+                cl_object buffer = ecl_aref1(#1, done);
+                cl_index size = (#3 == Cnil)? ecl_length(buffer) :
+                        fixnnint(ecl_aref1(#3, done));
+                char *data = octet_buffer(buffer, 0, size);
+                struct sockaddr_in name;
+                ssize_t len;
+                if (#4 != Cnil)
+                        load_inet_address(&name, ecl_aref1(#4, done),
+                                          ecl_aref1(#5, done));
+                ecl_disable_interrupts();
+                if (#4 != Cnil)
+                        len = sendto(#0, data, size, flags,
+                                     (struct sockaddr*)&name,
+                                     sizeof(struct sockaddr_in));
+                else
+                        len = send(#0, data, size, flags);
+                if (len < 0) error = errno;
+                ecl_enable_interrupts();
+                if (len < 0)
+                        break;
+        }
+#endif
+        @(return 0) = (done == 0 && error)? -1 : done;
+        @(return 1) = error;
+}
+"
+                  :one-liner nil)
+      (cond ((>= sent 0)
+             sent)
+            ((or (= errno +eagain+) (= errno +eintr+))
+             nil)
+            (t
+             (socket-error "send"))))))
+
 ;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;
 ;;;
 ;;; UNIX SOCKETS
@@ -1169,7 +1502,7 @@ also known as unix-domain sockets."))
 		  buffering)
 	    (t :int :int :object)
 	    t
-	    "si_set_buffering_mode(ecl_make_stream_from_fd(#0,#1,(enum ecl_smmode)#2,8,ECL_STREAM_DEFAULT_FORMAT,Cnil), #3)"
+	    "si_set_buffering_mode(2,ecl_make_stream_from_fd(#0,#1,(enum ecl_smmode)#2,8,ECL_STREAM_DEFAULT_FORMAT,Cnil), #3)"
 	    :one-liner t))
 
 (defmethod socket-make-stream ((socket socket)  &rest args &key (buffering nil))
@@ -146,6 +146,55 @@
 	(> (length data) 0))))
   t)
 
+(defun make-loopback-udp-socket ()
+  (let ((s (make-instance 'inet-socket :type :datagram :protocol :udp)))
+    (socket-bind s #(127 0 0 1) 0)
+    s))
+
+(deftest udp-send-receive-octets
+  (let ((a (make-loopback-udp-socket))
+	(b (make-loopback-udp-socket))
+	(out (make-array 6 :element-type '(unsigned-byte 8)
+			   :initial-contents '(1 2 3 4 5 6)))
+	(in (make-array 6 :element-type '(unsigned-byte 8) :initial-element 0))
+	(address (make-array 4)))
+    (unwind-protect
+	 (progn
+	   (socket-send-octets a out :start 1 :end 4 :address #(127 0 0 1)
+			       :port (nth-value 1 (socket-name b)))
+	   (multiple-value-bind (length port)
+	       (socket-receive-octets b in :start 2 :address address)
+	     (list length (= port (nth-value 1 (socket-name a)))
+		   address in)))
+      (socket-close a)
+      (socket-close b)))
+  (3 t #(127 0 0 1) #(0 0 2 3 4 0)))
+
+(deftest udp-send-receive-batch
+  (let* ((a (make-loopback-udp-socket))
+	 (b (make-loopback-udp-socket))
+	 (n 100)
+	 (out (make-array n))
+	 (in (make-array n))
+	 (lengths (make-array n :element-type 'fixnum)))
+    (dotimes (i n)
+      (setf (aref out i) (make-array (1+ (mod i 7)) :element-type '(unsigned-byte 8)
+				     :initial-element (mod i 256))
+	    (aref in i) (make-array 8 :element-type '(unsigned-byte 8))))
+    (unwind-protect
+	 (progn
+	   (socket-connect a #(127 0 0 1) (nth-value 1 (socket-name b)))
+	   (socket-send-batch a out)
+	   (sleep 0.1)
+	   (list (socket-receive-batch b in lengths)
+		 (loop for i below n
+		       always (and (= (aref lengths i) (1+ (mod i 7)))
+				   (= (aref (aref in i) 0) (mod i 256))))
+		 (socket-receive-batch b in lengths :dontwait t)))
+      (socket-close a)
+      (socket-close b)))
+  (100 t nil))
+
 ;;; A fairly rudimentary test that connects to the syslog socket and
 ;;; sends a message.  Priority 7 is kern.debug; you'll probably want
 ;;; to look at /etc/syslog.conf or local equivalent to find out where
@@ -0,0 +1,57 @@
+#|
+Throughput of WRITE-SEQUENCE and READ-SEQUENCE on binary files, for
+vectors of each specialized integer type and for floats, in both byte
+orders. Float vectors go to files of unsigned bytes of the same size.
+The speed is printed in megabytes of the file per second. Run it as
+
+  ecl -norc -load binary-io.lsp
+
+and compare the numbers before and after a change to the binary
+streams in src/c/file.d.
+|#
+
+(defconstant +bytes+ (* 8 1024 1024))
+(defconstant +passes+ 4)
+(defvar *file* "binary-io.tmp")
+
+(defun stream-type (type)
+  (case type
+    (single-float '(unsigned-byte 32))
+    (double-float '(unsigned-byte 64))
+    (t type)))
+
+(defun make-data (type)
+  (let* ((size (if (atom type) 8 (/ (second type) 8)))
+         (size (if (eq type 'single-float) 4 size)))
+    (make-array (/ +bytes+ size) :element-type type
+                :initial-element (coerce 1 type))))
+
+(defun seconds (function)
+  (let ((start (get-internal-real-time)))
+    (dotimes (i +passes+) (funcall function))
+    (/ (max 1 (- (get-internal-real-time) start))
+       internal-time-units-per-second)))
+
+(defun measure (type endian)
+  (let* ((data (make-data type))
+         (options (list :element-type (stream-type type)
+                        :external-format endian))
+         (write-time
+          (seconds (lambda ()
+                     (with-open-stream (s (apply #'open *file* :direction :output
+                                                 :if-exists :supersede options))
+                       (write-sequence data s)))))
+         (read-time
+          (seconds (lambda ()
+                     (with-open-stream (s (apply #'open *file* options))
+                       (read-sequence data s)))))
+         (mb (/ (* +bytes+ +passes+) 1048576.0)))
+    (format t "~&;;; ~20A ~14A ~10,1F MB/s write ~10,1F MB/s read~%"
+            type endian (/ mb write-time) (/ mb read-time))))
+
+(dolist (type '((unsigned-byte 8) (signed-byte 16) (unsigned-byte 32)
+                (signed-byte 64) single-float double-float))
+  (dolist (endian '(:big-endian :little-endian))
+    (measure type endian)))
+
+(delete-file *file*)
@@ -0,0 +1,66 @@
+#|
+Multithreaded microbenchmark for the allocation of small objects. Each
+process builds short lists, conses up bignums and allocates instances,
+dropping them right away, so that the time is spent in the allocator and
+in the garbage collector. The total amount of work is fixed, so that on
+a machine with enough cores the elapsed time should drop as processes
+are added, unless the allocator serializes them. Run it as
+
+  ecl -norc -load consing-mt.lsp
+
+in an ECL built with threads, and compare the timings before and after
+a change to src/c/alloc_2.d.
+|#
+
+(defconstant +objects+ 4000000)
+(defconstant +processes+ '(1 2 4 8))
+
+(defclass point () ((x :initarg :x) (y :initarg :y)))
+
+(defun cons-lists (n)
+  (let ((list nil))
+    (dotimes (i (floor n 4) (length list))
+      (setf list (list i i i i)))))
+
+(defun cons-bignums (n)
+  (let ((x (expt 2 70)))
+    (dotimes (i n x)
+      (setf x (+ (expt 2 70) i)))))
+
+(defun cons-instances (n)
+  (let ((class (find-class 'point))
+        (p nil))
+    (dotimes (i (floor n 4) p)
+      (setf p (allocate-instance class)))))
+
+(defun run-processes (functions)
+  "Runs each function in a process of its own and waits for all of
+them to finish."
+  (let* ((n (length functions))
+         (done (make-array n :initial-element nil)))
+    (loop for f in functions
+          for i from 0
+          do (let ((f f) (i i))
+               (mp:process-run-function
+                (format nil "bench-~D" i)
+                #'(lambda () (funcall f) (setf (aref done i) t)))))
+    (loop until (every #'identity done)
+          do (mp:process-yield))))
+
+(defun bench (name function processes)
+  (let ((n (floor +objects+ processes))
+        (start (get-internal-real-time)))
+    (run-processes (loop repeat processes
+                         collect #'(lambda () (funcall function n))))
+    (format t "~&;;; ~10A ~3D processes ~8D objects ~8,3F secs~%"
+            name processes +objects+
+            (/ (- (get-internal-real-time) start)
+               internal-time-units-per-second))))
+
+(defun run-all ()
+  (dolist (processes +processes+)
+    (bench "conses" #'cons-lists processes)
+    (bench "bignums" #'cons-bignums processes)
+    (bench "instances" #'cons-instances processes)))
+
+(run-all)
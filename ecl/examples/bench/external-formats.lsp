@@ -0,0 +1,75 @@
+#|
+Throughput of WRITE-STRING and READ-SEQUENCE on character files, for
+each external format. A text of a few megabytes, mostly ASCII with some
+accented letters, is written to a temporary file and read back in large
+chunks, and the speed is printed in megabytes of the file per second.
+Formats which can not encode the text get the ASCII part only. Run it as
+
+  ecl -norc -load external-formats.lsp
+
+and compare the numbers before and after a change to the encoders and
+decoders in src/c/file.d. Without Unicode support only the default
+format is measured.
+|#
+
+(defconstant +chars+ (* 4 1024 1024))
+(defconstant +chunk+ 65536)
+(defconstant +passes+ 4)
+(defvar *file* "external-formats.tmp")
+
+(defun make-text (ascii-only)
+  (let ((s (make-string +chars+)))
+    (dotimes (i +chars+ s)
+      (setf (char s i)
+            (cond ((zerop (mod i 71)) #\Newline)
+                  ((and (not ascii-only) (zerop (mod i 13)))
+                   (code-char (+ 224 (mod i 25))))
+                  (t (code-char (+ 32 (mod i 95)))))))))
+
+(defun write-text (text format)
+  (with-open-file (s *file* :direction :output :if-exists :supersede
+                            :external-format format)
+    (loop for i from 0 below (length text) by +chunk+
+          do (write-string text s :start i
+                                  :end (min (length text) (+ i +chunk+))))))
+
+(defun read-text (format)
+  (let ((buffer (make-string +chunk+))
+        (chars 0))
+    (with-open-file (s *file* :external-format format)
+      (loop for n = (read-sequence buffer s)
+            while (plusp n)
+            do (incf chars n)))
+    chars))
+
+(defun seconds (function)
+  (let ((start (get-internal-real-time)))
+    (dotimes (i +passes+) (funcall function))
+    (/ (max 1 (- (get-internal-real-time) start))
+       internal-time-units-per-second)))
+
+(defun measure (format ascii-only)
+  (let* ((text (make-text ascii-only))
+         (write-time (seconds (lambda () (write-text text format))))
+         (bytes (with-open-file (s *file* :element-type '(unsigned-byte 8))
+                  (file-length s)))
+         (read-time (seconds (lambda () (read-text format))))
+         (mb (/ (* bytes +passes+) 1048576.0)))
+    (format t "~&;;; ~16A ~10D bytes ~10,1F MB/s write ~10,1F MB/s read~%"
+            format bytes (/ mb write-time) (/ mb read-time))))
+
+#-unicode
+(measure :default nil)
+
+#+unicode
+(progn
+  (measure :latin-1 nil)
+  (measure :us-ascii t)
+  (measure :utf-8 t)
+  (measure :utf-8 nil)
+  (measure :ucs-2le nil)
+  (measure :ucs-4be nil)
+  (measure :iso-8859-15 nil)
+  (measure '(:utf-8 :crlf) nil))
+
+(delete-file *file*)
@@ -0,0 +1,75 @@
+#|
+Benchmark for the pauses of the garbage collector on a large live heap.
+It builds a heap of a few million conses and then runs a mutator which
+replaces a small part of it at every step, while producing garbage, so
+that the collector keeps running with most of the heap still alive.
+
+The collector is either stop-the-world, and then every collection marks
+the whole heap, or incremental and generational, when ECL was built with
+--enable-gengc, booted with the option ECL_OPT_INCREMENTAL_GC, or when
+the environment variable GC_ENABLE_INCREMENTAL is set. Run it as
+
+  ecl -norc -load gc-latency.lsp
+
+and it will launch ECL twice, without and with GC_ENABLE_INCREMENTAL,
+printing the pauses reported by EXT:GC-STATISTICS and the time taken by
+the slowest and by the average step of the mutator, which also includes
+the marking that the incremental collector does while allocating.
+|#
+
+(defconstant +live-conses+ 4000000)
+(defconstant +steps+ 2000)
+(defconstant +replaced-per-step+ 500)
+(defconstant +garbage-per-step+ 5000)
+
+(defvar *live*)
+
+(defun build-heap ()
+  (let ((v (make-array (floor +live-conses+ 2))))
+    (dotimes (i (length v) v)
+      (setf (aref v i) (list i i)))))
+
+(defun mutate (n)
+  (let ((v *live*))
+    (dotimes (i +replaced-per-step+)
+      (setf (aref v (random (length v))) (list n i)))
+    (dotimes (i (floor +garbage-per-step+ 10))
+      (make-list 10))))
+
+(defun run (mode)
+  (setf *live* (build-heap))
+  (gc t)
+  (let ((start (get-internal-real-time))
+        (worst 0))
+    (dotimes (n +steps+)
+      (let ((step-start (get-internal-real-time)))
+        (mutate n)
+        (setf worst (max worst (- (get-internal-real-time) step-start)))))
+    (let ((stats (ext:gc-statistics))
+          (total (- (get-internal-real-time) start)))
+      (format t "~&;;; ~12A ~6D gcs max pause ~8,3F mean pause ~8,3F msecs~%"
+              mode (getf stats :gc-count)
+              (* 1000 (getf stats :gc-max-pause))
+              (* 1000 (getf stats :gc-mean-pause)))
+      (format t "~&;;; ~12A ~6D steps max step  ~8,3F mean step  ~8,3F msecs~%"
+              mode +steps+
+              (/ (* 1000 worst) internal-time-units-per-second)
+              (/ (* 1000 total) internal-time-units-per-second +steps+)))))
+
+(defun launch (&rest environment)
+  (multiple-value-bind (stream code)
+      (ext:run-program "env"
+                       (append environment
+                               (list "GC_LATENCY_CHILD=1" (si:argv 0) "-norc"
+                                     "-load" (namestring *load-truename*)
+                                     "-eval" "(quit)"))
+                       :input nil :output t :error t)
+    (declare (ignore stream))
+    (unless (eql code 0)
+      (error "Benchmark exited with code ~A" code))))
+
+(if (ext:getenv "GC_LATENCY_CHILD")
+    (run (if (ext:getenv "GC_ENABLE_INCREMENTAL") "incremental" "full"))
+    (progn
+      (launch "-u" "GC_ENABLE_INCREMENTAL")
+      (launch "GC_ENABLE_INCREMENTAL=1")))
@@ -0,0 +1,90 @@
+#|
+Microbenchmark for the dispatch of generic functions. It calls generic
+functions with one, two and three specialized arguments on instances of
+a few classes, so that after the first calls every dispatch is a hit in
+the cache of the function. The same calls are then split among several
+processes, which share the caches and should not contend for any lock.
+Run it as
+
+  ecl -norc -load gf-dispatch.lsp
+
+and compare the timings before and after a change to src/c/gfun.d.
+|#
+
+(defconstant +calls+ 400000)
+(defconstant +processes+ '(1 2 4 8))
+
+(defclass shape () ())
+(defclass circle (shape) ())
+(defclass square (shape) ())
+(defclass triangle (shape) ())
+
+(defgeneric area (x))
+(defmethod area ((x shape)) 0)
+(defmethod area ((x circle)) 1)
+(defmethod area ((x square)) 2)
+
+(defgeneric combine (x y))
+(defmethod combine ((x shape) (y shape)) 0)
+(defmethod combine ((x circle) (y square)) 1)
+(defmethod combine ((x square) (y circle)) 2)
+
+(defgeneric combine3 (x y z))
+(defmethod combine3 ((x shape) (y shape) (z shape)) 0)
+(defmethod combine3 ((x circle) (y square) (z triangle)) 1)
+(defmethod combine3 ((x triangle) (y shape) (z circle)) 2)
+
+(defvar *shapes*
+  (map 'vector #'make-instance '(circle square triangle shape)))
+
+(defun call-1 (n)
+  (let ((shapes *shapes*) (sum 0))
+    (dotimes (i n sum)
+      (incf sum (area (svref shapes (logand i 3)))))))
+
+(defun call-2 (n)
+  (let ((shapes *shapes*) (sum 0))
+    (dotimes (i n sum)
+      (incf sum (combine (svref shapes (logand i 3))
+                         (svref shapes (logand (ash i -2) 3)))))))
+
+(defun call-3 (n)
+  (let ((shapes *shapes*) (sum 0))
+    (dotimes (i n sum)
+      (incf sum (combine3 (svref shapes (logand i 3))
+                          (svref shapes (logand (ash i -2) 3))
+                          (svref shapes (logand (ash i -4) 3)))))))
+
+(defun run-processes (functions)
+  "Runs each function in a process of its own and waits for all of
+them to finish."
+  (let* ((n (length functions))
+         (done (make-array n :initial-element nil)))
+    (loop for f in functions
+          for i from 0
+          do (let ((f f) (i i))
+               (mp:process-run-function
+                (format nil "bench-~D" i)
+                #'(lambda () (funcall f) (setf (aref done i) t)))))
+    (loop until (every #'identity done)
+          do (mp:process-yield))))
+
+(defun bench (name function processes)
+  (let ((n (floor +calls+ processes))
+        (start (get-internal-real-time)))
+    (run-processes (loop repeat processes
+                         collect #'(lambda () (funcall function n))))
+    (format t "~&;;; ~20A ~3D processes ~8D calls ~8,3F secs~%"
+            name processes +calls+
+            (/ (- (get-internal-real-time) start)
+               internal-time-units-per-second))))
+
+(defun run-all ()
+  ;; Warm the caches
+  (call-1 64) (call-2 64) (call-3 64)
+  (dolist (processes +processes+)
+    (bench "1 specialized arg" #'call-1 processes)
+    (bench "2 specialized args" #'call-2 processes)
+    (bench "3 specialized args" #'call-3 processes)))
+
+(run-all)
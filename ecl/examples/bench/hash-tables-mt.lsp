@@ -0,0 +1,75 @@
+#|
+Multithreaded microbenchmark for hash tables. Several processes look
+up keys in a shared table, with a writer updating it from time to time.
+It compares a :LOCKABLE table, in which every lookup takes the lock of
+the table, against a :SYNCHRONIZED one, whose readers do not lock.
+The total number of lookups is fixed, so that on a machine with enough
+cores the elapsed time should drop as processes are added. Run it as
+
+  ecl -norc -load hash-tables-mt.lsp
+
+in an ECL built with threads, and compare the timings before and after
+a change to src/c/hash.d.
+|#
+
+(defconstant +entries+ 10000)
+(defconstant +lookups+ 800000)
+(defconstant +processes+ '(1 2 4 8))
+
+(defun make-table (mode)
+  (let ((table (ecase mode
+                 (:lockable (make-hash-table :test 'equal :lockable t))
+                 (:synchronized (make-hash-table :test 'equal :synchronized t))))
+        (keys (make-array +entries+)))
+    (dotimes (i +entries+)
+      (let ((key (format nil "key-~D" i)))
+        (setf (aref keys i) key
+              (gethash key table) i)))
+    (values table keys)))
+
+(defun reader (table keys n)
+  (let ((hits 0)
+        (size (length keys)))
+    (dotimes (i n hits)
+      (when (gethash (aref keys (mod i size)) table)
+        (incf hits)))))
+
+(defun writer (table keys n)
+  (let ((size (length keys)))
+    (dotimes (i n)
+      (setf (gethash (aref keys (mod (* i 7) size)) table) i))))
+
+(defun run-processes (functions)
+  "Runs each function in a process of its own and waits for all of
+them to finish."
+  (let* ((n (length functions))
+         (done (make-array n :initial-element nil)))
+    (loop for f in functions
+          for i from 0
+          do (let ((f f) (i i))
+               (mp:process-run-function
+                (format nil "bench-~D" i)
+                #'(lambda () (funcall f) (setf (aref done i) t)))))
+    (loop until (every #'identity done)
+          do (mp:process-yield))))
+
+(defun bench-mode (mode processes)
+  (multiple-value-bind (table keys)
+      (make-table mode)
+    (let ((n (floor +lookups+ processes))
+          (start (get-internal-real-time)))
+      (run-processes
+       (cons #'(lambda () (writer table keys (floor n 100)))
+             (loop repeat processes
+                   collect #'(lambda () (reader table keys n)))))
+      (format t "~&;;; ~15A ~3D processes ~8D lookups ~8,3F secs~%"
+              mode processes +lookups+
+              (/ (- (get-internal-real-time) start)
+                 internal-time-units-per-second)))))
+
+(defun run-all ()
+  (dolist (mode '(:lockable :synchronized))
+    (dolist (processes +processes+)
+      (bench-mode mode processes))))
+
+(run-all)
@@ -0,0 +1,73 @@
+#|
+Microbenchmark for hash tables. It fills tables with each of the four
+standard tests, looks up present and absent keys, and removes half of
+the entries, and it also interns and finds symbols in a package, which
+uses the internal symbol tables of packages. Run it as
+
+  ecl -norc -load hash-tables.lsp
+
+and compare the timings before and after a change to src/c/hash.d.
+Most of the time is spent in the C core, so the functions need not be
+compiled.
+|#
+
+(defconstant +entries+ 100000)
+(defconstant +lookups+ 4)
+
+(defun make-keys (test n)
+  (let ((keys (make-array n)))
+    (dotimes (i n keys)
+      (setf (aref keys i)
+            (ecase test
+              (eq (make-symbol "KEY"))
+              (eql (if (evenp i) (* i 7919) (* i 1.5d0)))
+              (equal (format nil "key-~D" i))
+              (equalp (list (format nil "Key-~D" i) i)))))))
+
+(defun bench-table (test keys)
+  (let* ((n (length keys))
+         (table (make-hash-table :test test))
+         (hits 0))
+    (dotimes (i n)
+      (setf (gethash (aref keys i) table) i))
+    (dotimes (j +lookups+)
+      (dotimes (i n)
+        (when (gethash (aref keys i) table)
+          (incf hits))
+        (when (gethash i table)
+          (incf hits))))
+    (dotimes (i n)
+      (when (evenp i)
+        (remhash (aref keys i) table)))
+    (dotimes (i n)
+      (gethash (aref keys i) table))
+    hits))
+
+(defun bench-package (n)
+  (let ((package (or (find-package "HASH-BENCH")
+                     (make-package "HASH-BENCH" :use nil)))
+        (names (make-array n)))
+    (dotimes (i n)
+      (setf (aref names i) (format nil "SYMBOL-~D" i)))
+    (dotimes (i n)
+      (intern (aref names i) package))
+    (dotimes (j +lookups+)
+      (dotimes (i n)
+        (find-symbol (aref names i) package)
+        (find-symbol (aref names i) "CL")))
+    (delete-package package)))
+
+(defun run (name function &rest args)
+  (let ((start (get-internal-run-time)))
+    (apply function args)
+    (format t "~&;;; ~40A ~8D entries ~8,3F secs~%" name +entries+
+            (/ (- (get-internal-run-time) start)
+               internal-time-units-per-second))))
+
+(defun run-all ()
+  (dolist (test '(eq eql equal equalp))
+    (let ((keys (make-keys test +entries+)))
+      (run (format nil "~A table" test) #'bench-table test keys)))
+  (run "package symbols" #'bench-package +entries+))
+
+(run-all)
@@ -0,0 +1,66 @@
+#|
+Microbenchmark for the creation of standard instances and the access to
+their slots. It makes many small instances with MAKE-INSTANCE, keeps a
+fraction of them alive, and then reads and writes their slots both with
+accessors and with SLOT-VALUE, walking the live ones in an order that
+does not follow their addresses, so that cache misses show up. Run it as
+
+  ecl -norc -load instances.lsp
+
+and compare the timings before and after a change to the layout of
+instances in src/c/alloc_2.d or src/c/instance.d.
+|#
+
+(defconstant +instances+ 200000)
+(defconstant +live+ 100000)
+(defconstant +passes+ 10)
+
+(defclass point ()
+  ((x :initarg :x :accessor point-x)
+   (y :initarg :y :accessor point-y)
+   (z :initarg :z :accessor point-z)
+   (tag :initform nil :accessor point-tag)))
+
+(defmacro bench (name &body body)
+  `(let ((start (get-internal-real-time))
+         (gcs (getf (ext:gc-statistics) :gc-count)))
+     (multiple-value-prog1 (progn ,@body)
+       (format t "~&;;; ~24A ~8,3F secs ~5D gcs~%" ,name
+               (/ (- (get-internal-real-time) start)
+                  internal-time-units-per-second)
+               (- (getf (ext:gc-statistics) :gc-count) gcs)))))
+
+(defun make-points (n)
+  (let (p)
+    (dotimes (i n p)
+      (setf p (make-instance 'point :x i :y (1+ i) :z (- i))))))
+
+(defun live-points (n)
+  (let ((v (make-array n)))
+    (dotimes (i n)
+      (setf (aref v i) (make-instance 'point :x i :y (1+ i) :z (- i)))
+      ;; Garbage in between, so that live instances are spread around
+      (make-instance 'point :x i :y i :z i))
+    ;; Visit them in a scattered order
+    (loop for i from (1- n) downto 1
+          do (rotatef (aref v i) (aref v (random (1+ i)))))
+    v))
+
+(defun read-accessors (v)
+  (let ((sum 0))
+    (declare (fixnum sum))
+    (dotimes (k +passes+ sum)
+      (loop for p across v
+            do (setf sum (logand most-positive-fixnum
+                                 (+ sum (point-x p) (point-y p))))))))
+
+(defun write-slot-value (v)
+  (dotimes (k +passes+)
+    (loop for p across v
+          do (setf (slot-value p 'tag) k
+                   (slot-value p 'z) (slot-value p 'x)))))
+
+(bench "make-instance" (make-points +instances+))
+(defvar *points* (bench "live instances" (live-points +live+)))
+(bench "accessors" (read-accessors *points*))
+(bench "slot-value" (write-slot-value *points*))
@@ -0,0 +1,55 @@
+#|
+Microbenchmark for the lexical environment of the bytecodes
+interpreter. It times reads and assignments of local variables in
+nested LET forms, loops that create closures, and calls to local
+functions, all of them interpreted. Run it as
+
+  ecl -norc -load interpreter-env.lsp
+
+and compare the timings before and after a change to the bytecodes
+compiler (src/c/compiler.d) or interpreter (src/c/interpreter.d).
+|#
+
+(defconstant +iterations+ 1000000)
+
+(defun bench-deep-vars (n)
+  (let ((a 1) (b 2) (c 3) (d 4))
+    (let ((e 5) (f 6) (g 7) (h 8))
+      (let ((sum 0))
+        (dotimes (i n sum)
+          (setq sum (logand (+ sum a b c d e f g h) #xffff)))))))
+
+(defun bench-closures (n)
+  (let ((total 0))
+    (dotimes (i n total)
+      (let ((k i))
+        (setq total (logand (+ total (funcall (lambda () k))) #xffff))))))
+
+(defun bench-labels (n)
+  (labels ((add (x y) (if (zerop y) x (add (1+ x) (1- y)))))
+    (let ((sum 0))
+      (dotimes (i n sum)
+        (setq sum (logand (+ sum (add i 3)) #xffff))))))
+
+(defun bench-block (n)
+  (let ((count 0))
+    (dotimes (i n count)
+      (block inner
+        (tagbody
+         again
+           (incf count)
+           (when (oddp count) (go again))
+           (return-from inner))))))
+
+(defun run (name function n)
+  (let ((start (get-internal-run-time)))
+    (funcall function n)
+    (format t "~&;;; ~40A ~8D iterations ~8,3F secs~%" name n
+            (/ (- (get-internal-run-time) start)
+               internal-time-units-per-second))))
+
+(defun run-all ()
+  (dolist (f '(bench-deep-vars bench-closures bench-labels bench-block))
+    (run (format nil "~A interpreted" f) f +iterations+)))
+
+(run-all)
@@ -0,0 +1,74 @@
+#|
+Reading a binary file with READ-BYTE, with READ-SEQUENCE in small chunks
+and at random positions, first through the usual buffered stream and
+then through a stream opened with :MMAP T, and finally scanning the
+vector returned by EXT:MAPPED-FILE-VECTOR without copying. Run it as
+
+  ecl -norc -load mapped-files.lsp
+
+and compare the timings of both kinds of streams, or before and after a
+change to the file streams in src/c/file.d.
+|#
+
+(declaim (optimize (speed 3) (safety 1)))
+
+(defconstant +bytes+ (* 16 1024 1024))
+(defconstant +chunk+ 64)
+(defconstant +seeks+ 200000)
+(defvar *file* "mapped-files.tmp")
+
+(defmacro bench (name &body body)
+  `(let ((start (get-internal-real-time)))
+     (multiple-value-prog1 (progn ,@body)
+       (format t "~&;;; ~32A ~8,3F secs~%" ,name
+               (/ (- (get-internal-real-time) start)
+                  internal-time-units-per-second)))))
+
+(defun open-bytes (mmap)
+  (open *file* :element-type '(unsigned-byte 8) :mmap mmap))
+
+(defun sum-bytes (mmap)
+  (with-open-stream (s (open-bytes mmap))
+    (loop for b = (read-byte s nil nil)
+          while b
+          sum b fixnum)))
+
+(defun sum-chunks (mmap)
+  (let ((v (make-array +chunk+ :element-type '(unsigned-byte 8))))
+    (with-open-stream (s (open-bytes mmap))
+      (loop for n = (read-sequence v s)
+            while (plusp n)
+            sum (aref v 0) fixnum))))
+
+(defun sum-random (mmap)
+  (let ((v (make-array +chunk+ :element-type '(unsigned-byte 8)))
+        (state (make-random-state nil)))
+    (with-open-stream (s (open-bytes mmap))
+      (loop repeat +seeks+
+            do (file-position s (random (- +bytes+ +chunk+) state))
+               (read-sequence v s)
+            sum (aref v 0) fixnum))))
+
+(defun sum-vector ()
+  (with-open-stream (s (open-bytes t))
+    (let ((v (ext:mapped-file-vector s)))
+      (declare (type (simple-array (unsigned-byte 8) (*)) v))
+      (loop for b across v sum b fixnum))))
+
+;;; Compiled, so that the streams and not the interpreter are measured
+(mapc #'compile '(sum-bytes sum-chunks sum-random sum-vector))
+
+(with-open-file (s *file* :direction :output :if-exists :supersede
+                          :element-type '(unsigned-byte 8))
+  (let ((v (make-array +bytes+ :element-type '(unsigned-byte 8))))
+    (dotimes (i +bytes+) (setf (aref v i) (random 256)))
+    (write-sequence v s)))
+
+(dolist (mmap '(nil t))
+  (format t "~&;;; ~:[Buffered stream~;Mapped file~]~%" mmap)
+  (bench "read-byte" (sum-bytes mmap))
+  (bench "read-sequence" (sum-chunks mmap))
+  (bench "file-position + read-sequence" (sum-random mmap)))
+(bench "mapped-file-vector" (sum-vector))
+
+(delete-file *file*)
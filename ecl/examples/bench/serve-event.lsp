@@ -0,0 +1,99 @@
+#|
+Cost of SERVE-EVENT with many idle connections. A small set of socket
+pairs pass a byte back and forth through SERVE-EVENT handlers, while
+thousands of other connections, whose client ends are held by a child
+ECL process, have handlers that never run. The number of messages per
+second is printed for each count of idle connections. Run it as
+
+  ulimit -n 20000; ecl -norc -load serve-event.lsp
+
+and compare the numbers before and after a change to the event loop in
+contrib/serve-event/serve-event.lisp. Only the epoll(7) version handles
+descriptors beyond FD_SETSIZE.
+|#
+
+(require 'sockets)
+(require 'serve-event)
+(use-package :sb-bsd-sockets)
+
+(defconstant +active+ 16)
+(defconstant +seconds+ 2)
+(defvar *idle-counts* '(0 100 1000 10000))
+
+(defun make-listener ()
+  (let ((socket (make-instance 'inet-socket :type :stream :protocol :tcp)))
+    (setf (sockopt-reuse-address socket) t)
+    (socket-bind socket #(127 0 0 1) 0)
+    (socket-listen socket 1024)
+    socket))
+
+(defun connect-to (listener)
+  (let ((socket (make-instance 'inet-socket :type :stream :protocol :tcp)))
+    (socket-connect socket #(127 0 0 1) (nth-value 1 (socket-name listener)))
+    socket))
+
+;;; The child opens COUNT connections and keeps them until its input
+;;; is closed.
+(defun open-idle-connections (listener count)
+  (let* ((script (format nil "(progn (require 'sockets)
+                                (let (l) (dotimes (i ~D) (push (make-instance
+                                  'sb-bsd-sockets:inet-socket :type :stream
+                                  :protocol :tcp) l) (sb-bsd-sockets:socket-connect
+                                  (first l) #(127 0 0 1) ~D)))
+                                (read-line *standard-input* nil) (quit))"
+                         count (nth-value 1 (socket-name listener))))
+         (child (ext:run-program (si:argv 0) (list "-norc" "-eval" script)
+                                 :input :stream :output nil :wait nil)))
+    (values child (loop repeat count collect (socket-accept listener)))))
+
+(defun ping-pong (listener idle)
+  (let ((pairs (loop repeat +active+
+                     collect (let ((client (connect-to listener)))
+                               (cons client (socket-accept listener)))))
+        (byte (make-array 1 :element-type '(unsigned-byte 8)))
+        (messages 0)
+        (handlers '()))
+    (flet ((relay (from to)
+             (push (serve-event:add-fd-handler
+                    (socket-file-descriptor from) :input
+                    #'(lambda (fd)
+                        (declare (ignore fd))
+                        (socket-receive from byte nil)
+                        (incf messages)
+                        (socket-send to byte 1)))
+                   handlers)))
+      (dolist (socket idle)
+        (push (serve-event:add-fd-handler (socket-file-descriptor socket) :input
+                                          #'(lambda (fd) (declare (ignore fd))))
+              handlers))
+      (loop for (client . server) in pairs
+            do (relay client client)
+               (relay server server)
+               (socket-send client byte 1))
+      (let ((end (+ (get-internal-real-time)
+                    (* +seconds+ internal-time-units-per-second))))
+        (loop while (< (get-internal-real-time) end)
+              do (serve-event:serve-event 1)))
+      (mapc #'serve-event:remove-fd-handler handlers)
+      (loop for (client . server) in pairs
+            do (socket-close client) (socket-close server))
+      (/ messages +seconds+))))
+
+(defun measure (idle-count)
+  (let ((listener (make-listener)))
+    (multiple-value-bind (child idle)
+        (open-idle-connections listener idle-count)
+      (unwind-protect
+           (format t "~&;;; ~6D idle connections ~10D messages/s~%"
+                   idle-count (round (ping-pong listener idle)))
+        (mapc #'socket-close idle)
+        (close child)
+        (socket-close listener)))))
+
+;;; Compiled, so that the event loop and not the interpreter is measured
+(mapc #'compile '(open-idle-connections ping-pong))
+
+(dolist (count *idle-counts*)
+  (handler-case (measure count)
+    (error (c)
+      (format t "~&;;; ~6D idle connections failed: ~A~%" count c))))
@@ -0,0 +1,53 @@
+#|
+Microbenchmark for dynamic bindings of special variables. It measures
+LET of specials, reads of dynamically bound specials and SETQ of a
+bound special in tight loops, both interpreted and compiled. Run it as
+
+  ecl -norc -load special-bindings.lsp
+
+and compare the timings of a threaded ECL before and after a change
+to the binding stack (src/c/stacks.d).
+|#
+
+(defvar *a* 0)
+(defvar *b* 0)
+(defvar *c* 0)
+
+(defconstant +iterations+ 2000000)
+
+(defun bench-let (n)
+  (dotimes (i n)
+    (let ((*a* i))
+      (let ((*b* *a*) (*c* *a*))
+        (setq *c* *b*)))))
+
+(defun bench-read (n)
+  (let ((*a* 1) (*b* 2))
+    (let ((sum 0))
+      (declare (fixnum sum))
+      (dotimes (i n sum)
+        (setq sum (logand (+ sum *a* *b*) #xffff))))))
+
+(defun bench-print-vars (n)
+  (dotimes (i n)
+    (let ((*print-base* 16)
+          (*print-radix* t)
+          (*print-escape* nil)
+          (*print-pretty* t))
+      (setq *print-pretty* *print-escape*))))
+
+(defun run (name function n)
+  (let ((start (get-internal-run-time)))
+    (funcall function n)
+    (format t "~&;;; ~40A ~8D iterations ~8,3F secs~%" name n
+            (/ (- (get-internal-run-time) start)
+               internal-time-units-per-second))))
+
+(defun run-all ()
+  (dolist (f '(bench-let bench-read bench-print-vars))
+    (run (format nil "~A interpreted" f) f (floor +iterations+ 10)))
+  (dolist (f '(bench-let bench-read bench-print-vars))
+    (compile f)
+    (run (format nil "~A compiled" f) f +iterations+)))
+
+(run-all)
@@ -0,0 +1,112 @@
+#|
+Benchmark for the startup time of ECL. It launches the same executable
+repeatedly, doing nothing but quitting, so that the time is spent
+initializing the core libraries (LSP, CLOS and, when built in, the
+compiler), which is mostly the decoding of their constants by read_VV()
+in src/c/read.d. Run it as
+
+  ecl -norc -load startup.lsp
+
+and compare the timings before and after a change to src/c/read.d or to
+the way src/cmp/cmpwt.lsp writes the data of compiled files. The elapsed
+time is what matters here, so it is measured with the real time clock.
+
+It then builds a small program which embeds ECL, saves a heap image
+with EXT:SAVE-IMAGE from it and times booting the program with and
+without the image. The program fails when ecl_boot_image() does not use
+the image, or when the image does not hold what was defined before
+saving it, so this also checks src/c/image.d. It needs a C compiler and
+the headers and libraries of the installed ECL.
+|#
+
+(defconstant +launches+ 20)
+
+(defun ecl-program ()
+  (si:argv 0))
+
+(defun launch (program args &optional (expected-code 0))
+  (multiple-value-bind (stream code)
+      (ext:run-program program args :input nil :output nil :error nil)
+    (declare (ignore stream))
+    (unless (eql code expected-code)
+      (error "~A exited with code ~A" program code))))
+
+(defun run (name program args &optional (expected-code 0))
+  (let ((start (get-internal-real-time)))
+    (dotimes (i +launches+)
+      (launch program args expected-code))
+    (format t "~&;;; ~40A ~4D launches ~8,3F msecs each~%" name +launches+
+            (/ (* 1000 (- (get-internal-real-time) start))
+               internal-time-units-per-second +launches+))))
+
+#|
+The embedding program boots from the image named by its first argument
+and evaluates the other ones, exiting with the code of ecl_boot_image(),
+or with 3 when a form returns NIL. It refers to cl_core and to Cnil,
+which lives in cl_symbols, as most such programs do: unless it is
+compiled as position independent code, linking it with a shared libecl
+then copies both into the program.
+|#
+(defparameter *embedding-program* "
+#include <ecl/ecl.h>
+
+int
+main(int argc, char **argv)
+{
+	int i, booted = ecl_boot_image(argc, argv, argv[1]);
+	if (cl_core.user_package == Cnil)
+		return 3;
+	for (i = 2; i < argc; i++) {
+		if (cl_eval(c_string_to_object(argv[i])) == Cnil)
+			return 3;
+	}
+	cl_shutdown();
+	return booted;
+}
+")
+
+(defun build-embedding-program (directory)
+  (let ((c-file (merge-pathnames "embed.c" directory))
+        (o-file (merge-pathnames "embed.o" directory))
+        (program (merge-pathnames "embed" directory)))
+    (with-open-file (s c-file :direction :output :if-exists :supersede)
+      (write-string *embedding-program* s))
+    (c::compiler-cc c-file o-file)
+    (c::linker-cc program (namestring o-file))
+    (namestring program)))
+
+(defun run-image (directory)
+  (let* ((program (build-embedding-program directory))
+         (image (namestring (merge-pathnames "embed.img" directory))))
+    (when (probe-file image)
+      (delete-file image))
+    ;; A normal boot, which saves the image with a function, a hash
+    ;; table and a stream over a mapped file in it
+    (launch program
+            (list image
+                  "(defun image-test (x) (* x 2))"
+                  "(defparameter *image-table* (make-hash-table :test 'equal))"
+                  "(setf (gethash \"key\" *image-table*) 'value)"
+                  (format nil "(defparameter *image-stream* (open ~S :mmap t))"
+                          (namestring (merge-pathnames "embed.c" directory)))
+                  (format nil "(ext:save-image ~S)" image))
+            1)
+    (launch program
+            (list image "(= (image-test 21) 42)"
+                  "(eq (gethash \"key\" *image-table*) 'value)"
+                  "(not (open-stream-p *image-stream*))"
+                  "(null (ext:mapped-file-vector *image-stream*))")
+            2)
+    (run "embedding program, normal boot" program (list "no-image") 1)
+    (run "embedding program, boot from image" program (list image) 2)))
+
+(defun run-all ()
+  (run "ecl -norc -eval (quit)" (ecl-program) '("-norc" "-eval" "(quit)"))
+  (let ((directory (pathname (format nil "/tmp/ecl-startup-~D/"
+                                     (random 1000000 (make-random-state t))))))
+    (ensure-directories-exist directory)
+    (handler-case (run-image directory)
+      (error (c)
+        (format t "~&;;; Booting from a heap image failed: ~A~%" c)))))
+
+(run-all)
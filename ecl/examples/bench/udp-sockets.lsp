@@ -0,0 +1,84 @@
+#|
+Rate of small UDP datagrams over the loopback interface, sent and
+received in groups of +BATCH+ with SOCKET-SEND and SOCKET-RECEIVE, with
+SOCKET-SEND-OCTETS and SOCKET-RECEIVE-OCTETS, which reuse the caller's
+vectors, and with SOCKET-SEND-BATCH and SOCKET-RECEIVE-BATCH, which move
+a whole group per system call. The number of messages per second and
+the bytes allocated per message are printed. Run it as
+
+  ecl -norc -load udp-sockets.lsp
+
+and compare the numbers before and after a change to the socket I/O in
+contrib/sockets/sockets.lisp.
+|#
+
+(require 'sockets)
+(use-package :sb-bsd-sockets)
+
+(defconstant +size+ 64)
+(defconstant +batch+ 32)
+(defconstant +rounds+ 20000)
+
+(defun make-udp-socket ()
+  (let ((socket (make-instance 'inet-socket :type :datagram :protocol :udp)))
+    (socket-bind socket #(127 0 0 1) 0)
+    socket))
+
+(defun make-octets ()
+  (make-array +size+ :element-type '(unsigned-byte 8) :initial-element 1))
+
+(defun generic-functions (sender receiver)
+  (let ((data (make-octets)))
+    (dotimes (i +rounds+)
+      (dotimes (j +batch+) (socket-send sender data nil))
+      (dotimes (j +batch+)
+        (socket-receive receiver nil +size+ :element-type '(unsigned-byte 8))))))
+
+(defun octets (sender receiver)
+  (let ((data (make-octets))
+        (buffer (make-octets))
+        (sender (socket-file-descriptor sender))
+        (receiver (socket-file-descriptor receiver)))
+    (dotimes (i +rounds+)
+      (dotimes (j +batch+) (socket-send-octets sender data))
+      (dotimes (j +batch+) (socket-receive-octets receiver buffer)))))
+
+(defun batches (sender receiver)
+  (let ((data (make-array +batch+))
+        (buffers (make-array +batch+))
+        (lengths (make-array +batch+ :element-type 'fixnum))
+        (sender (socket-file-descriptor sender))
+        (receiver (socket-file-descriptor receiver)))
+    (dotimes (j +batch+)
+      (setf (aref data j) (make-octets)
+            (aref buffers j) (make-octets)))
+    (dotimes (i +rounds+)
+      (socket-send-batch sender data)
+      (loop with left = +batch+
+            while (plusp left)
+            do (decf left (socket-receive-batch receiver buffers lengths
+                                                :count left))))))
+
+;;; Compiled, so that the sockets and not the interpreter are measured
+(mapc #'compile '(generic-functions octets batches))
+
+(defun measure (name function)
+  (let ((sender (make-udp-socket))
+        (receiver (make-udp-socket))
+        (messages (* +rounds+ +batch+)))
+    (socket-connect sender #(127 0 0 1) (nth-value 1 (socket-name receiver)))
+    (si:gc-stats t)
+    (let ((bytes (si:gc-stats t))
+          (start (get-internal-real-time)))
+      (funcall function sender receiver)
+      (let ((seconds (/ (max 1 (- (get-internal-real-time) start))
+                        internal-time-units-per-second)))
+        (format t "~&;;; ~20A ~10D messages/s ~8,1F bytes/message~%"
+                name (round messages seconds)
+                (/ (- (si:gc-stats t) bytes) messages 1.0))))
+    (socket-close sender)
+    (socket-close receiver)))
+
+(measure "socket-send/receive" #'generic-functions)
+(measure "octets" #'octets)
+(measure "batch" #'batches)
@@ -1646,7 +1646,7 @@ cl_symbols[] = {
 
 {SYS_ "*ACTION-ON-UNDEFINED-VARIABLE*", SI_SPECIAL, NULL, -1, Cnil},
 
-{SYS_ "SET-BUFFERING-MODE", SI_ORDINARY, si_set_buffering_mode, 2, OBJNULL},
+{SYS_ "SET-BUFFERING-MODE", SI_ORDINARY, si_set_buffering_mode, -1, OBJNULL},
 {KEY_ "NONE", KEYWORD, NULL, -1, OBJNULL},
 {KEY_ "LINE-BUFFERED", KEYWORD, NULL, -1, OBJNULL},
 {KEY_ "FULLY-BUFFERED", KEYWORD, NULL, -1, OBJNULL},
@@ -1842,5 +1842,47 @@ cl_symbols[] = {
 {EXT_ "*PROGRAM-EXIT-CODE*", EXT_SPECIAL, NULL, -1, MAKE_FIXNUM(0)},
 {EXT_ "EXIT", EXT_ORDINARY, si_exit, -1, OBJNULL},
 
+{KEY_ "WEAKNESS", KEYWORD, NULL, -1, OBJNULL},
+{KEY_ "VALUE", KEYWORD, NULL, -1, OBJNULL},
+{KEY_ "KEY-AND-VALUE", KEYWORD, NULL, -1, OBJNULL},
+{KEY_ "KEY-OR-VALUE", KEYWORD, NULL, -1, OBJNULL},
+{EXT_ "HASH-TABLE-WEAKNESS", EXT_ORDINARY, si_hash_table_weakness, 1, OBJNULL},
+{KEY_ "SYNCHRONIZED", KEYWORD, NULL, -1, OBJNULL},
+{EXT_ "HASH-TABLE-SYNCHRONIZED-P", EXT_ORDINARY, si_hash_table_synchronized_p, 1, OBJNULL},
+{KEY_ "INCREMENTAL-REHASH", KEYWORD, NULL, -1, OBJNULL},
+
+#ifdef GBC_BOEHM
+{EXT_ "GC-STATISTICS", EXT_ORDINARY, si_gc_statistics, -1, OBJNULL},
+#endif
+{KEY_ "BYTES-ALLOCATED", KEYWORD, NULL, -1, OBJNULL},
+{KEY_ "OBJECTS-ALLOCATED", KEYWORD, NULL, -1, OBJNULL},
+{KEY_ "GC-COUNT", KEYWORD, NULL, -1, OBJNULL},
+{KEY_ "GC-TIME", KEYWORD, NULL, -1, OBJNULL},
+{KEY_ "GC-MAX-PAUSE", KEYWORD, NULL, -1, OBJNULL},
+{KEY_ "GC-MEAN-PAUSE", KEYWORD, NULL, -1, OBJNULL},
+
+#ifdef GBC_BOEHM
+{EXT_ "HEAP-CENSUS", EXT_ORDINARY, si_heap_census, -1, OBJNULL},
+#endif
+{EXT_ "SAVE-IMAGE", EXT_ORDINARY, si_save_image, 1, OBJNULL},
+{KEY_ "SINCE", KEYWORD, NULL, -1, OBJNULL},
+{KEY_ "OTHER", KEYWORD, NULL, -1, OBJNULL},
+
+{SYS_ "FINALIZER-THREAD", SI_ORDINARY, NULL, -1, OBJNULL},
+{KEY_ "FINALIZERS-RUN", KEYWORD, NULL, -1, OBJNULL},
+{KEY_ "FINALIZERS-PENDING", KEYWORD, NULL, -1, OBJNULL},
+{KEY_ "FINALIZER-TIME", KEYWORD, NULL, -1, OBJNULL},
+
+#ifdef GBC_BOEHM
+{SYS_ "CALL-WITH-ALLOCATION-REGION", SI_ORDINARY, si_call_with_allocation_region, 1, OBJNULL},
+#endif
+{EXT_ "WITH-ALLOCATION-REGION", EXT_ORDINARY, NULL, -1, OBJNULL},
+{KEY_ "REGIONS-RELEASED", KEYWORD, NULL, -1, OBJNULL},
+{KEY_ "REGIONS-PROMOTED", KEYWORD, NULL, -1, OBJNULL},
+{KEY_ "REGION-BYTES-FREED", KEYWORD, NULL, -1, OBJNULL},
+
+{KEY_ "MMAP", KEYWORD, NULL, -1, OBJNULL},
+{EXT_ "MAPPED-FILE-VECTOR", EXT_ORDINARY, si_mapped_file_vector, 1, OBJNULL},
+
 /* Tag for end of list */
 {NULL, CL_ORDINARY, NULL, -1, OBJNULL}};
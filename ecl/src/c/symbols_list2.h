@@ -1842,5 +1842,47 @@ cl_symbols[] = {
 {EXT_ "*PROGRAM-EXIT-CODE*",NULL},
 {EXT_ "EXIT","si_exit"},
 
+{KEY_ "WEAKNESS",NULL},
+{KEY_ "VALUE",NULL},
+{KEY_ "KEY-AND-VALUE",NULL},
+{KEY_ "KEY-OR-VALUE",NULL},
+{EXT_ "HASH-TABLE-WEAKNESS","si_hash_table_weakness"},
+{KEY_ "SYNCHRONIZED",NULL},
+{EXT_ "HASH-TABLE-SYNCHRONIZED-P","si_hash_table_synchronized_p"},
+{KEY_ "INCREMENTAL-REHASH",NULL},
+
+#ifdef GBC_BOEHM
+{EXT_ "GC-STATISTICS","si_gc_statistics"},
+#endif
+{KEY_ "BYTES-ALLOCATED",NULL},
+{KEY_ "OBJECTS-ALLOCATED",NULL},
+{KEY_ "GC-COUNT",NULL},
+{KEY_ "GC-TIME",NULL},
+{KEY_ "GC-MAX-PAUSE",NULL},
+{KEY_ "GC-MEAN-PAUSE",NULL},
+
+#ifdef GBC_BOEHM
+{EXT_ "HEAP-CENSUS","si_heap_census"},
+#endif
+{EXT_ "SAVE-IMAGE","si_save_image"},
+{KEY_ "SINCE",NULL},
+{KEY_ "OTHER",NULL},
+
+{SYS_ "FINALIZER-THREAD",NULL},
+{KEY_ "FINALIZERS-RUN",NULL},
+{KEY_ "FINALIZERS-PENDING",NULL},
+{KEY_ "FINALIZER-TIME",NULL},
+
+#ifdef GBC_BOEHM
+{SYS_ "CALL-WITH-ALLOCATION-REGION","si_call_with_allocation_region"},
+#endif
+{EXT_ "WITH-ALLOCATION-REGION",NULL},
+{KEY_ "REGIONS-RELEASED",NULL},
+{KEY_ "REGIONS-PROMOTED",NULL},
+{KEY_ "REGION-BYTES-FREED",NULL},
+
+{KEY_ "MMAP",NULL},
+{EXT_ "MAPPED-FILE-VECTOR","si_mapped_file_vector"},
+
 /* Tag for end of list */
 {NULL,NULL}};
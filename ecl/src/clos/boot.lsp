@@ -176,6 +176,42 @@
   (and (find-slot-definition (class-of self) slot-name)
        t))
 
+;;;
+;;; Calls to SLOT-VALUE with a constant slot name are replaced by the
+;;; compiler with calls to this function, which gets a cache of its own,
+;;; (LIST NIL), for each call site. The cache holds the location of the
+;;; slot for the classes recently seen. Only instances of STANDARD-CLASS and
+;;; FUNCALLABLE-STANDARD-CLASS are cached, because for other metaclasses
+;;; SLOT-VALUE-USING-CLASS may have been redefined.
+;;;
+
+(defun cached-slot-value (self slot-name cache)
+  (declare (cons cache))
+  (let ((location nil))
+    (when (and (si::instancep self)
+	       (si:sl-boundp (si::instance-sig self)))
+      (ensure-up-to-date-instance self)
+      (setf location
+	    (or (slot-cache-location (car cache) self)
+		(let* ((class (si:instance-class self))
+		       (slotd (and (or (eq (si:instance-class class)
+					   +the-standard-class+)
+				       (eq (si:instance-class class)
+					   +the-funcallable-standard-class+))
+				   (gethash slot-name (slot-table class) nil))))
+		  (when slotd
+		    (let ((location (slot-definition-location slotd)))
+		      (slot-cache-add (car cache) self location)
+		      location))))))
+    (if location
+	(let ((value (if (si:fixnump location)
+			 (si:instance-ref self (the fixnum location))
+			 (car (the cons location)))))
+	  (if (si:sl-boundp value)
+	      value
+	      (values (slot-unbound (class-of self) self slot-name))))
+	(slot-value self slot-name))))
+
 ;;;
 ;;; 2) Overloadable methods on which the previous functions are based
 ;;;
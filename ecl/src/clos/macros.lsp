@@ -29,3 +29,26 @@
 
 
 
+
+(defmacro slot-cache-location (cache instance)
+  ;; Inline caches for slot access are lists of up to four records
+  ;; #(class signature location), one for each class recently seen. The
+  ;; signature is the list of slot definitions stored in the instance.sig
+  ;; field of each instance, which is created anew when the class is
+  ;; redefined or its instances are made obsolete, so that those changes
+  ;; make the cache miss. The list is never modified, only replaced.
+  ;; Returns NIL on a miss.
+  (let ((class (gensym)) (sig (gensym)) (record (gensym)))
+    `(let* ((,class (si::instance-class ,instance))
+            (,sig (si::instance-sig ,instance)))
+       (dolist (,record ,cache)
+         (when (and (eq (svref ,record 0) ,class)
+                    (eq (svref ,record 1) ,sig))
+           (return (svref ,record 2)))))))
+
+(defmacro slot-cache-add (cache instance location)
+  `(let ((old ,cache))
+     (setf ,cache (cons (vector (si::instance-class ,instance)
+                                (si::instance-sig ,instance)
+                                ,location)
+                        (if (nthcdr 3 old) (subseq old 0 3) old)))))
@@ -541,37 +541,43 @@ because it contains a reference to the undefined class~%  ~A"
 ;;;
 (defun std-class-optimized-accessors (slot-name)
   (declare (si::c-local))
+  ;; Each accessor has an inline cache (see SLOT-CACHE-LOCATION) with the
+  ;; locations of the slot in the classes it was last used on, so that only
+  ;; a miss looks up the slot table of the class.
   (macrolet ((slot-table (class)
 	       `(si::instance-ref ,class #.(position 'slot-table +standard-class-slots+
 						     :key #'first)))
 	     (slot-definition-location (slotd)
 	       `(si::instance-ref ,slotd #.(position 'location +slot-definition-slots+
-						     :key #'first))))
-    (values #'(lambda (self)
-                (declare (optimize (safety 0) (speed 3) (debug 0))
-                         (standard-object self))
-                (ensure-up-to-date-instance self)
-		(let* ((class (si:instance-class self))
-		       (table (slot-table class))
-		       (slotd (gethash slot-name table))
-		       (index (slot-definition-location slotd))
-		       (value (if (si::fixnump index)
-				  (si:instance-ref self (the fixnum index))
-				  (car (the cons index)))))
-		  (if (si:sl-boundp value)
-		      value
-		      (values (slot-unbound (class-of self) self slot-name)))))
-	    #'(lambda (value self)
-                (declare (optimize (safety 0) (speed 3) (debug 0))
-                         (standard-object self))
-                (ensure-up-to-date-instance self)
-		(let* ((class (si:instance-class self))
-		       (table (slot-table class))
-		       (slotd (gethash slot-name table))
-		       (index (slot-definition-location slotd)))
-		  (if (si::fixnump index)
-		      (si:instance-set self (the fixnum index) value)
-		      (rplaca (the cons index) value)))))))
+						     :key #'first)))
+	     (slot-location (self cache)
+	       `(or (slot-cache-location ,cache ,self)
+		    (let ((location (slot-definition-location
+				     (gethash slot-name
+					      (slot-table (si:instance-class ,self))))))
+		      (slot-cache-add ,cache ,self location)
+		      location))))
+    (let ((reader-cache nil)
+	  (writer-cache nil))
+      (values #'(lambda (self)
+		  (declare (optimize (safety 0) (speed 3) (debug 0))
+			   (standard-object self))
+		  (ensure-up-to-date-instance self)
+		  (let* ((index (slot-location self reader-cache))
+			 (value (if (si::fixnump index)
+				    (si:instance-ref self (the fixnum index))
+				    (car (the cons index)))))
+		    (if (si:sl-boundp value)
+			value
+			(values (slot-unbound (class-of self) self slot-name)))))
+	      #'(lambda (value self)
+		  (declare (optimize (safety 0) (speed 3) (debug 0))
+			   (standard-object self))
+		  (ensure-up-to-date-instance self)
+		  (let ((index (slot-location self writer-cache)))
+		    (if (si::fixnump index)
+			(si:instance-set self (the fixnum index) value)
+			(rplaca (the cons index) value))))))))
 
 (defun std-class-sealed-accessors (index)
   (declare (si::c-local)
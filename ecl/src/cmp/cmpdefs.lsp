@@ -530,6 +530,9 @@ lines are inserted, but the order is preserved")
 (defvar *compiler-constants* nil)	; a vector with all constants
 					; only used in COMPILE
 
+(defvar *binary-constants* t)		; T/NIL flag to write the constants of
+					; compiled files in binary form
+
 (defvar *proclaim-fixed-args* nil)	; proclaim automatically functions
 					; with fixed number of arguments.
 					; watch out for multiple values.
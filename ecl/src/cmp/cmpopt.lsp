@@ -314,6 +314,21 @@
 (define-compiler-macro coerce (&whole form value type &environment env)
   (expand-coerce form value type env))
 
+;;;
+;;; SLOT-VALUE
+;;;
+;;; With a constant slot name, each call site gets its own cache with the
+;;; location of the slot in the last class seen.
+;;;
+
+#+clos
+(define-compiler-macro slot-value (&whole form object slot-name)
+  (if (and (consp slot-name)
+           (eq (first slot-name) 'quote)
+           (symbolp (second slot-name)))
+      `(clos::cached-slot-value ,object ,slot-name (load-time-value (list nil)))
+      form))
+
 ;;;
 ;;; AREF/ASET
 ;;;
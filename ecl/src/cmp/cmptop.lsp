@@ -149,6 +149,10 @@
       (when *compile-file-truename*
         (wt-nl "flag->cblock.source = make_constant_base_string(\""
                (namestring *compile-file-truename*) "\");"))
+      ;; Codeblocks restored from a heap image already have their data
+      (wt-nl "#ifdef ECL_DYNAMIC_VV")
+      (wt-nl "VV = flag->cblock.data;")
+      (wt-nl "#endif")
       (wt-nl "return;}")
       (wt-nl "#ifdef ECL_DYNAMIC_VV")
       (wt-nl "VV = Cblock->cblock.data;")
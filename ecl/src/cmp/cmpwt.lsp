@@ -108,6 +108,9 @@
 	     (t (format stream "\\~3,'0o" (char-code x)))))
 	  ((char= x #\\)
 	   (princ "\\\\" stream))
+	  ;; Avoids trigraphs
+	  ((and (char= x #\?) (plusp i) (char= (aref string (1- i)) #\?))
+	   (princ "\\077" stream))
 	  ((char= x #\")
 	   (princ "\\\"" stream))
 	  (t (princ x stream)))))
@@ -163,11 +166,14 @@
              (format stream "~%#define compiler_data_text NULL~%#define compiler_data_text_size 0~%")
              (setf output (concatenate 'vector (data-get-all-objects))))
             ((plusp (data-size))
-             (wt-data-begin stream)
-             (wt-filtered-data
-              (subseq (prin1-to-string (data-get-all-objects)) 1)
-              stream)
-             (wt-data-end stream)))
+             (let ((objects (data-get-all-objects)))
+               (wt-data-begin stream)
+               (wt-filtered-data
+                (or (and *binary-constants*
+                         (data-binary-encoding objects))
+                    (subseq (prin1-to-string objects) 1))
+                stream)
+               (wt-data-end stream))))
       (when must-close
         (close must-close))
       (data-init)
@@ -184,6 +190,219 @@
   (format stream "~%#define compiler_data_text_size ~D~%" *wt-string-size*)
   (setf *wt-string-size* 0))
 
+;;; ======================================================================
+;;;
+;;; BINARY DATA
+;;;
+;;; When all constants are numbers, characters, symbols, strings, bit
+;;; vectors, vectors, pathnames or conses, the data section is written
+;;; in a binary form that read_VV() decodes without using the reader.
+;;; The format is described in src/c/read.d, and the operations below
+;;; are those of enum binary_data_op, in the same order.
+;;;
+
+(defparameter +binary-data-magic+ (format nil "~CECLB1" (code-char 0)))
+
+(defparameter +binary-data-ops+
+  '(:nil :fixnum :bignum :ratio :single-float :double-float :complex
+    :character :base-string :string :bit-vector :vector :cons :list
+    :symbol :symbol-value :pathname :label :reference))
+
+(defun data-binary-infinity (x)
+  ;; The printer writes infinities as #.EXT:...-INFINITY
+  (if (typep x 'single-float)
+      (if (plusp x)
+          'ext:single-float-positive-infinity
+          'ext:single-float-negative-infinity)
+      (if (plusp x)
+          'ext:double-float-positive-infinity
+          'ext:double-float-negative-infinity)))
+
+(defun data-binary-sharing (objects)
+  "Counts how many times each object that has identity appears in
+OBJECTS, stopping at the second time. Returns the counts and the list
+of packages of the symbols, or NIL if some constant has no binary form."
+  (let ((counts (make-hash-table :test #'eq))
+        (packages '()))
+    (labels ((seen-p (x)
+               (let ((n (gethash x counts 0)))
+                 (setf (gethash x counts) (1+ n))
+                 (plusp n)))
+             (visit (x)
+               (loop
+                 (typecase x
+                   (symbol
+                    (let ((p (symbol-package x)))
+                      (cond ((null p) (seen-p x))
+                            ((eq p (find-package "KEYWORD")))
+                            (t (pushnew p packages))))
+                    (return))
+                   ((or integer ratio character)
+                    (return))
+                   ((or single-float double-float)
+                    (cond ((/= x x)             ; NaN
+                           (return-from data-binary-sharing nil))
+                          ((ext:float-infinity-p x)
+                           (setf x (data-binary-infinity x)))
+                          (t
+                           (return))))
+                   (complex
+                    (visit (realpart x))
+                    (setf x (imagpart x)))
+                   ((or string bit-vector)
+                    (seen-p x)
+                    (return))
+                   ((vector t)
+                    (unless (seen-p x)
+                      (map nil #'visit x))
+                    (return))
+                   (pathname
+                    (unless (equal (parse-namestring (namestring x)) x)
+                      (return-from data-binary-sharing nil))
+                    (seen-p x)
+                    (return))
+                   (cons
+                    (when (seen-p x)
+                      (return))
+                    (visit (car x))
+                    (setf x (cdr x)))
+                   (t
+                    (return-from data-binary-sharing nil))))))
+      (mapc #'visit objects)
+      (values counts (nreverse packages)))))
+
+(defun data-binary-encoding (objects)
+  "Returns a string with the binary form of the list of OBJECTS, or NIL
+if some of them can not be written in binary form."
+  (multiple-value-bind (counts packages)
+      (data-binary-sharing objects)
+    (unless counts
+      (return-from data-binary-encoding nil))
+    (let ((output (make-array 1024 :element-type 'base-char
+                              :adjustable t :fill-pointer 0))
+          (labels (make-hash-table :test #'eq))
+          (nlabels 0))
+      (labels ((put-byte (b)
+                 (vector-push-extend (code-char b) output))
+               (put-op (op)
+                 (put-byte (position op +binary-data-ops+)))
+               (put-unsigned (n)
+                 (loop (let ((b (ldb (byte 7 0) n)))
+                         (setf n (ash n -7))
+                         (when (zerop n)
+                           (return (put-byte b)))
+                         (put-byte (logior b #x80)))))
+               (put-signed (n)
+                 (put-unsigned (if (minusp n) (1- (* -2 n)) (* 2 n))))
+               (put-string (s)
+                 (put-unsigned (length s))
+                 (if (typep s 'base-string)
+                     (loop for c across s do (put-byte (char-code c)))
+                     (loop for c across s do (put-unsigned (char-code c)))))
+               (put-name (s)
+                 ;; Names of symbols and packages are never shared
+                 (put-op (if (typep s 'base-string) :base-string :string))
+                 (put-string s))
+               (put-float (op x)
+                 (when (ext:float-infinity-p x)
+                   (put-op :symbol-value)
+                   (put-symbol (data-binary-infinity x))
+                   (return-from put-float))
+                 (multiple-value-bind (significand exponent sign)
+                     (integer-decode-float x)
+                   (put-op op)
+                   (put-signed (+ (* 2 exponent) (if (minusp sign) 1 0)))
+                   (put-unsigned significand)))
+               (put-symbol (x)
+                 ;; Like PKG::NAME, as the printer does in the text form
+                 (let ((p (symbol-package x)))
+                   (put-op :symbol)
+                   (put-unsigned (cond ((null p) 0)
+                                       ((eq p (find-package "KEYWORD")) 1)
+                                       (t (+ 2 (position p packages)))))
+                   (put-name (symbol-name x))))
+               (put-list (x)
+                 (let ((n 1)
+                       (tail (cdr x)))
+                   ;; Shared conses must begin a list of their own
+                   (loop while (and (consp tail) (< (gethash tail counts 0) 2))
+                         do (incf n) (setf tail (cdr tail)))
+                   (put-op :list)
+                   (put-unsigned n)
+                   (loop repeat n
+                         for l on x
+                         do (put-object (car l)))
+                   (put-object tail)))
+               (put-object (x)
+                 (let ((label (gethash x labels)))
+                   (when label
+                     (put-op :reference)
+                     (put-unsigned label)
+                     (return-from put-object))
+                   (when (> (gethash x counts 0) 1)
+                     (setf (gethash x labels) nlabels)
+                     (incf nlabels)
+                     (put-op :label)))
+                 (typecase x
+                   (null (put-op :nil))
+                   (symbol (put-symbol x))
+                   (fixnum (put-op :fixnum) (put-signed x))
+                   (integer
+                    (put-op :bignum)
+                    (let ((n (ceiling (integer-length (abs x)) 8)))
+                      (put-unsigned (+ (* 2 n) (if (minusp x) 1 0)))
+                      (dotimes (i n)
+                        (put-byte (ldb (byte 8 (* 8 i)) (abs x))))))
+                   (ratio
+                    (put-op :ratio)
+                    (put-object (numerator x))
+                    (put-object (denominator x)))
+                   (single-float (put-float :single-float x))
+                   (double-float (put-float :double-float x))
+                   (complex
+                    (put-op :complex)
+                    (put-object (realpart x))
+                    (put-object (imagpart x)))
+                   (character
+                    (put-op :character)
+                    (put-unsigned (char-code x)))
+                   (base-string
+                    (put-op :base-string)
+                    (put-string x))
+                   (string
+                    (put-op :string)
+                    (put-string x))
+                   (bit-vector
+                    (put-op :bit-vector)
+                    (put-unsigned (length x))
+                    (dotimes (i (ceiling (length x) 8))
+                      (let ((b 0))
+                        (dotimes (j 8)
+                          (let ((k (+ (* 8 i) j)))
+                            (when (and (< k (length x)) (= 1 (bit x k)))
+                              (setf b (logior b (ash #x80 (- j)))))))
+                        (put-byte b))))
+                   (vector
+                    (put-op :vector)
+                    (put-unsigned (length x))
+                    (map nil #'put-object x))
+                   (pathname
+                    (put-op :pathname)
+                    (put-name (namestring x)))
+                   (cons (put-list x)))))
+        (mapc #'put-object objects)
+        (let ((body output))
+          (setf output (make-array (+ (length body) 64) :element-type 'base-char
+                                   :adjustable t :fill-pointer 0))
+          (loop for c across +binary-data-magic+ do (vector-push-extend c output))
+          (put-unsigned nlabels)
+          (put-unsigned (length packages))
+          (dolist (p packages)
+            (put-name (package-name p)))
+          (put-unsigned (length objects))
+          (loop for c across body do (vector-push-extend c output))
+          output)))))
+
 (defun data-empty-loc ()
   (add-object 0 :duplicate t :permanent t))
 
@@ -18,12 +18,26 @@ enum {
   OP_CDR,
   OP_LIST,
   OP_LISTA,
+  OP_PLUS,
+  OP_MINUS,
+  OP_TIMES,
+  OP_ONEPLUS,
+  OP_ONEMINUS,
+  OP_NUMEQ,
+  OP_LT,
+  OP_GT,
+  OP_LE,
+  OP_GE,
+  OP_EQ,
+  OP_EQL,
   OP_INT,
   OP_PINT,
   OP_VAR,
+  OP_VARC,
   OP_VARS,
   OP_PUSH,
   OP_PUSHV,
+  OP_PUSHVC,
   OP_PUSHVS,
   OP_PUSHQ,
   OP_CALLG1,
@@ -53,19 +67,24 @@ enum {
   OP_JT,
   OP_JEQL,
   OP_JNEQL,
-  OP_UNBIND,
   OP_UNBINDS,
   OP_BIND,
+  OP_BINDC,
   OP_PBIND,
+  OP_PBINDC,
   OP_VBIND,
+  OP_VBINDC,
   OP_BINDS,
   OP_PBINDS,
   OP_VBINDS,
   OP_SETQ,
+  OP_SETQC,
   OP_SETQS,
   OP_PSETQ,
+  OP_PSETQC,
   OP_PSETQS,
   OP_VSETQ,
+  OP_VSETQC,
   OP_VSETQS,
   OP_BLOCK,
   OP_DO,
@@ -175,12 +194,26 @@ typedef int16_t cl_oparg;
   &&LBL_OP_CDR - &&LBL_OP_NOP,\
   &&LBL_OP_LIST - &&LBL_OP_NOP,\
   &&LBL_OP_LISTA - &&LBL_OP_NOP,\
+  &&LBL_OP_PLUS - &&LBL_OP_NOP,\
+  &&LBL_OP_MINUS - &&LBL_OP_NOP,\
+  &&LBL_OP_TIMES - &&LBL_OP_NOP,\
+  &&LBL_OP_ONEPLUS - &&LBL_OP_NOP,\
+  &&LBL_OP_ONEMINUS - &&LBL_OP_NOP,\
+  &&LBL_OP_NUMEQ - &&LBL_OP_NOP,\
+  &&LBL_OP_LT - &&LBL_OP_NOP,\
+  &&LBL_OP_GT - &&LBL_OP_NOP,\
+  &&LBL_OP_LE - &&LBL_OP_NOP,\
+  &&LBL_OP_GE - &&LBL_OP_NOP,\
+  &&LBL_OP_EQ - &&LBL_OP_NOP,\
+  &&LBL_OP_EQL - &&LBL_OP_NOP,\
   &&LBL_OP_INT - &&LBL_OP_NOP,\
   &&LBL_OP_PINT - &&LBL_OP_NOP,\
   &&LBL_OP_VAR - &&LBL_OP_NOP,\
+  &&LBL_OP_VARC - &&LBL_OP_NOP,\
   &&LBL_OP_VARS - &&LBL_OP_NOP,\
   &&LBL_OP_PUSH - &&LBL_OP_NOP,\
   &&LBL_OP_PUSHV - &&LBL_OP_NOP,\
+  &&LBL_OP_PUSHVC - &&LBL_OP_NOP,\
   &&LBL_OP_PUSHVS - &&LBL_OP_NOP,\
   &&LBL_OP_PUSHQ - &&LBL_OP_NOP,\
   &&LBL_OP_CALLG1 - &&LBL_OP_NOP,\
@@ -210,19 +243,24 @@ typedef int16_t cl_oparg;
   &&LBL_OP_JT - &&LBL_OP_NOP,\
   &&LBL_OP_JEQL - &&LBL_OP_NOP,\
   &&LBL_OP_JNEQL - &&LBL_OP_NOP,\
-  &&LBL_OP_UNBIND - &&LBL_OP_NOP,\
   &&LBL_OP_UNBINDS - &&LBL_OP_NOP,\
   &&LBL_OP_BIND - &&LBL_OP_NOP,\
+  &&LBL_OP_BINDC - &&LBL_OP_NOP,\
   &&LBL_OP_PBIND - &&LBL_OP_NOP,\
+  &&LBL_OP_PBINDC - &&LBL_OP_NOP,\
   &&LBL_OP_VBIND - &&LBL_OP_NOP,\
+  &&LBL_OP_VBINDC - &&LBL_OP_NOP,\
   &&LBL_OP_BINDS - &&LBL_OP_NOP,\
   &&LBL_OP_PBINDS - &&LBL_OP_NOP,\
   &&LBL_OP_VBINDS - &&LBL_OP_NOP,\
   &&LBL_OP_SETQ - &&LBL_OP_NOP,\
+  &&LBL_OP_SETQC - &&LBL_OP_NOP,\
   &&LBL_OP_SETQS - &&LBL_OP_NOP,\
   &&LBL_OP_PSETQ - &&LBL_OP_NOP,\
+  &&LBL_OP_PSETQC - &&LBL_OP_NOP,\
   &&LBL_OP_PSETQS - &&LBL_OP_NOP,\
   &&LBL_OP_VSETQ - &&LBL_OP_NOP,\
+  &&LBL_OP_VSETQC - &&LBL_OP_NOP,\
   &&LBL_OP_VSETQS - &&LBL_OP_NOP,\
   &&LBL_OP_BLOCK - &&LBL_OP_NOP,\
   &&LBL_OP_DO - &&LBL_OP_NOP,\
@@ -5,6 +5,15 @@ extern "C" {
 
 #define _ARGS(x) x
 
+/*
+ * Allocation counters. They should not wrap around on 32-bit platforms.
+ */
+#ifdef ecl_uint64_t
+typedef ecl_uint64_t ecl_alloc_count;
+#else
+typedef cl_index ecl_alloc_count;
+#endif
+
 /*
  * Per-thread data.
  */
@@ -39,7 +48,15 @@ struct cl_env_struct {
 	struct bds_bd *bds_org;
 	struct bds_bd *bds_top;
 	struct bds_bd *bds_limit;
-	cl_object bindings_hash;
+#ifdef ECL_THREADS
+	/*
+	 * Thread-local values of special variables, indexed by the
+	 * symbol's binding index. Unused slots hold ECL_NO_TL_BINDING.
+	 */
+	cl_index thread_local_bindings_size;
+	cl_object *thread_local_bindings;
+	cl_object bindings_array;
+#endif
 
 	/*
 	 * The Invocation History Stack (IHS) keeps a list of the names of the
@@ -92,22 +109,24 @@ struct cl_env_struct {
 	   BIGNUM_REGISTER_SIZE in config.h */
 	cl_object big_register[3];
 
+#ifdef GBC_BOEHM
+	/* ... and the allocator: free lists of small objects */
+	void **alloc_lists;
+	ecl_alloc_count bytes_allocated;
+	ecl_alloc_count objects_allocated;
+	/* innermost region of ext:with-allocation-region, or NULL */
+	struct ecl_alloc_region *alloc_region;
+#endif
+
 #ifdef ECL_THREADS
 	cl_object own_process;
 #endif
 	cl_object pending_interrupt;
 
-	/* The following is a hash table for caching invocations of
-	   generic functions. In a multithreaded environment we must
-	   queue operations in which the hash is cleared from updated
-	   generic functions. */
+	/* Scratch vector for the classes of the arguments to a generic
+	   function, which are looked up in the cache of the function. */
 #ifdef CLOS
-#ifdef ECL_THREADS
-	cl_object method_hash_clear_list;
-#endif
-	cl_object method_hash;
 	cl_object method_spec_vector;
-	cl_fixnum method_generation;
 #endif
 
 	/* foreign function interface */
@@ -209,17 +228,29 @@ struct cl_core_struct {
 #ifdef ECL_THREADS
 	cl_object processes;
 	cl_object global_lock;
+	cl_index last_var_index;
 #endif
 	cl_object libraries;
 	cl_object to_be_finalized;
+#ifdef CLOS
+	cl_fixnum method_generation;
+#endif
 
 	cl_index max_heap_size;
-	cl_object bytes_consed;
-	cl_object gc_counter;
 	bool gc_stats;
 	int path_max;
 #ifdef GBC_BOEHM
         char *safety_region;
+	ecl_alloc_count bytes_allocated;
+	ecl_alloc_count objects_allocated;
+	double gc_time;
+	double gc_max_pause;
+	cl_index gc_pauses;
+	double finalizer_time;
+	cl_index finalizers_run;
+	cl_index regions_released;
+	cl_index regions_promoted;
+	ecl_alloc_count region_bytes_freed;
 #endif
 #ifdef ECL_THREADS
 	cl_object signal_queue_lock;
@@ -241,12 +272,16 @@ extern ECL_API struct cl_core_struct cl_core;
 
 extern ECL_API cl_object ecl_alloc_object(cl_type t);
 extern ECL_API cl_object ecl_alloc_instance(cl_index slots);
+extern ECL_API cl_object ecl_alloc_bclosure(cl_index nrecords);
 extern ECL_API cl_object ecl_cons(cl_object a, cl_object d);
 extern ECL_API cl_object ecl_list1(cl_object a);
 #ifdef GBC_BOEHM
 extern ECL_API cl_object si_gc(cl_object area);
 extern ECL_API cl_object si_gc_dump(void);
 extern ECL_API cl_object si_gc_stats(cl_object enable);
+extern ECL_API cl_object si_gc_statistics(cl_narg narg, ...);
+extern ECL_API cl_object si_heap_census(cl_narg narg, ...);
+extern ECL_API cl_object si_call_with_allocation_region(cl_object function);
 extern ECL_API void *ecl_alloc_unprotected(cl_index n);
 extern ECL_API void *ecl_alloc_atomic_unprotected(cl_index n);
 extern ECL_API void *ecl_alloc(cl_index n);
@@ -629,8 +664,9 @@ extern ECL_API cl_object si_do_write_sequence(cl_object string, cl_object stream
 extern ECL_API cl_object si_do_read_sequence(cl_object string, cl_object stream, cl_object start, cl_object end);
 extern ECL_API cl_object si_file_column(cl_object strm);
 extern ECL_API cl_object cl_interactive_stream_p(cl_object strm);
-extern ECL_API cl_object si_set_buffering_mode(cl_object strm, cl_object mode);
+extern ECL_API cl_object si_set_buffering_mode(cl_narg narg, cl_object strm, cl_object mode, ...);
 extern ECL_API cl_object si_stream_external_format_set(cl_object strm, cl_object format);
+extern ECL_API cl_object si_mapped_file_vector(cl_object strm);
 
 extern ECL_API bool ecl_input_stream_p(cl_object strm);
 extern ECL_API bool ecl_output_stream_p(cl_object strm);
@@ -699,7 +735,6 @@ extern ECL_API void ecl_register_root(cl_object *p);
 /* gfun.c */
 
 #ifdef CLOS
-extern ECL_API void _ecl_set_method_hash_size(cl_env_ptr env, cl_index size);
 extern ECL_API cl_object si_clear_gfun_hash(cl_object what);
 extern ECL_API cl_object clos_set_funcallable_instance_function(cl_object x, cl_object function_or_t);
 extern ECL_API cl_object si_generic_function_p(cl_object instance);
@@ -723,6 +758,8 @@ extern ECL_API cl_object cl_hash_table_rehash_threshold(cl_object ht);
 extern ECL_API cl_object cl_hash_table_size(cl_object ht);
 extern ECL_API cl_object cl_hash_table_test(cl_object ht);
 extern ECL_API cl_object si_hash_table_iterator(cl_object ht);
+extern ECL_API cl_object si_hash_table_weakness(cl_object ht);
+extern ECL_API cl_object si_hash_table_synchronized_p(cl_object ht);
 extern ECL_API cl_object cl_make_hash_table _ARGS((cl_narg narg, ...));
 extern ECL_API cl_object cl_gethash _ARGS((cl_narg narg, cl_object key, cl_object ht, ...));
 extern ECL_API cl_object si_copy_hash_table(cl_object orig);
@@ -736,6 +773,10 @@ extern ECL_API cl_object ecl_gethash_safe(cl_object key, cl_object hash, cl_obje
 extern ECL_API bool ecl_remhash(cl_object key, cl_object hash);
 extern ECL_API struct ecl_hashtable_entry *ecl_search_hash(cl_object key, cl_object hashtable);
 
+/* image.c */
+
+extern ECL_API cl_object si_save_image(cl_object filename);
+
 /* instance.c */
 
 #ifdef CLOS
@@ -914,6 +955,7 @@ typedef enum {
 	ECL_OPT_HEAP_SAFETY_AREA,
         ECL_OPT_THREAD_INTERRUPT_SIGNAL,
         ECL_OPT_SET_GMP_MEMORY_FUNCTIONS,
+	ECL_OPT_FINALIZER_THREAD,
 	ECL_OPT_LIMIT
 } ecl_option;
 
@@ -921,6 +963,7 @@ extern ECL_API const char *ecl_self;
 extern ECL_API void ecl_set_option(int option, cl_fixnum value);
 extern ECL_API cl_fixnum ecl_get_option(int option);
 extern ECL_API int cl_boot(int argc, char **argv);
+extern ECL_API int ecl_boot_image(int argc, char **argv, const char *image);
 extern ECL_API void cl_shutdown(void);
 #if defined(_MSC_VER) || defined(mingw32)
 extern ECL_API void ecl_get_commandline_args(int* argc, char*** argv);
@@ -1648,6 +1691,7 @@ extern ECL_API cl_object cl_sleep(cl_object z);
 extern ECL_API cl_object cl_get_internal_run_time(void);
 extern ECL_API cl_object cl_get_internal_real_time(void);
 extern ECL_API cl_object cl_get_universal_time(void);
+extern ECL_API double ecl_realtime(void);
 
 
 /* typespec.c */
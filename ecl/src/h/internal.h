@@ -21,6 +21,13 @@ extern "C" {
  *	FUNCTIONS, VARIABLES AND TYPES NOT FOR GENERAL USE		*
  * -------------------------------------------------------------------- */
 
+/* Functions which never return, such as those signalling errors */
+#if defined(__GNUC__)
+#define ecl_attr_noreturn __attribute__((noreturn))
+#else
+#define ecl_attr_noreturn
+#endif
+
 /* booting */
 extern void init_all_symbols(void);
 extern void init_alloc(void);
@@ -57,10 +64,35 @@ extern void _ecl_dealloc_env(cl_env_ptr);
 
 #ifdef GBC_BOEHM
 #define ECL_COMPACT_OBJECT_EXTRA(x) ((void*)((x)->array.displaced))
+extern cl_object ecl_alloc_weak_pointer(cl_object o);
+/* Per-thread free lists hold objects of 1 to ECL_ALLOC_LISTS granules */
+#define ECL_ALLOC_GRANULE (2*sizeof(void*))
+#define ECL_ALLOC_LISTS 4
+extern void _ecl_init_alloc_lists(cl_env_ptr env);
+extern void _ecl_free_alloc_lists(cl_env_ptr env);
+extern void _ecl_retire_alloc_counters(cl_env_ptr env);
+extern void _ecl_start_finalizer_thread(void);
+/* Classes of heap memory, as saved by ext:save-image */
+enum ecl_image_class {
+	ECL_IMAGE_RAW_ATOMIC,	/* ecl_alloc_atomic() */
+	ECL_IMAGE_RAW,		/* ecl_alloc() */
+	ECL_IMAGE_UNCOLLECTABLE,
+	ECL_IMAGE_OBJECT,	/* conses and objects without descriptor */
+	ECL_IMAGE_ATOMIC_OBJECT, /* numbers, compact arrays, weak pointers */
+	ECL_IMAGE_TYPED		/* objects with a layout descriptor */
+};
+extern int _ecl_image_class(void *base, cl_index *size);
+extern void *_ecl_image_alloc(int klass, cl_index size, cl_type t);
+extern bool _ecl_image_pointer_field_p(cl_type t, cl_index word);
+extern void _ecl_image_restore_weak_pointer(cl_object o);
 #endif
 extern void _ecl_set_max_heap_size(cl_index new_size);
 extern cl_object ecl_alloc_bytecodes(cl_index data_size, cl_index code_size);
 
+/* big.d */
+
+extern cl_object _ecl_big_copy(cl_object old);
+
 /* compiler.d */
 
 struct cl_compiler_env {
@@ -71,6 +103,10 @@ struct cl_compiler_env {
 	cl_object lex_env;		/* Lexical env. for eval-when */
 	cl_index env_depth;
 	cl_index env_size;
+	struct cl_compiler_env *parent;	/* Enclosing function, if any */
+	cl_object locals;		/* Slots of the frame of this function */
+	cl_object upvalues;		/* Records in the closure environment */
+	cl_index nupvalues;
         int mode;
 	bool coalesce;
 	bool stepping;
@@ -166,6 +202,10 @@ typedef struct cl_compiler_env *cl_compiler_env_ptr;
 
 extern cl_object _ecl_bytecodes_dispatch_vararg(cl_narg narg, ...);
 extern cl_object _ecl_bclosure_dispatch_vararg(cl_narg narg, ...);
+extern cl_object _ecl_make_bclosure(cl_object code, cl_index nrecords);
+extern cl_object _ecl_close_around(cl_object fun, cl_object records);
+extern cl_object _ecl_closure_lex_env(cl_object closure);
+extern cl_object _ecl_frame_lex_env(cl_env_ptr env, cl_object bytecodes, cl_index frame);
 
 /* ffi.d */
 
@@ -231,6 +271,7 @@ extern void* ecl_dynamic_callback_make(cl_object data, enum ecl_ffi_calling_conv
 #define IO_FILE_COLUMN(strm) (strm)->stream.int1
 #define IO_FILE_ELT_TYPE(strm) (strm)->stream.object0
 #define IO_FILE_FILENAME(strm) (strm)->stream.object1
+extern void _ecl_image_restore_stream(cl_object strm);
 
 /* format.d */
 
@@ -240,6 +281,19 @@ extern cl_object si_formatter_aux _ARGS((cl_narg narg, cl_object strm, cl_object
 
 /* hash.d */
 extern cl_object ecl_extend_hashtable(cl_object hashtable);
+extern struct ecl_hashtable_entry _ecl_hash_entry(cl_object hashtable, cl_index i);
+extern void _ecl_finish_rehash(cl_object hashtable);
+extern void _ecl_rehash_moved_keys(cl_object hashtable);
+/* Key of the slots of an old vector whose entry was moved or removed */
+#define ECL_HASH_MOVED ((cl_object)(2 << 2))
+
+/* image.d */
+extern bool _ecl_load_image(const char *filename);
+
+/* main.d */
+#ifdef ECL_UNICODE
+extern void _ecl_set_char_database_pointers(void);
+#endif
 
 /* gfun.d, kernel.lsp */
 
@@ -278,6 +332,11 @@ extern void cl_write_object(cl_object x, cl_object stream);
 # define PACKAGE_OP_UNLOCK() THREAD_OP_UNLOCK()
 # define ERROR_HANDLER_LOCK() THREAD_OP_LOCK()
 # define ERROR_HANDLER_UNLOCK() THREAD_OP_UNLOCK()
+# ifdef _MSC_VER
+#  define ECL_MEMORY_BARRIER() MemoryBarrier()
+# else
+#  define ECL_MEMORY_BARRIER() __sync_synchronize()
+# endif
 #else
 # define HASH_TABLE_LOCK(h)
 # define HASH_TABLE_UNLOCK(h)
@@ -285,6 +344,7 @@ extern void cl_write_object(cl_object x, cl_object stream);
 # define PACKAGE_OP_UNLOCK()
 # define ERROR_HANDLER_LOCK()
 # define ERROR_HANDLER_UNLOCK()
+# define ECL_MEMORY_BARRIER()
 #endif /* ECL_THREADS */
 
 
@@ -295,6 +355,13 @@ extern void cl_write_object(cl_object x, cl_object stream);
 #define	RTABSIZE	CHAR_CODE_LIMIT	/*  read table size  */
 #endif
 
+/* stacks.d */
+
+#ifdef ECL_THREADS
+extern void ecl_set_bindings_array(cl_env_ptr env, cl_object vector);
+extern cl_object ecl_copy_bindings_array(cl_env_ptr env);
+#endif
+
 /* threads.d */
 
 #ifdef ECL_THREADS
@@ -307,6 +374,10 @@ extern ECL_API cl_object mp_break_suspend_loop();
 #define UTC_time_to_universal_time(x) ecl_plus(ecl_make_integer(x),cl_core.Jan1st1970UT)
 extern cl_fixnum ecl_runtime(void);
 
+/* typespec.d */
+
+extern cl_object ecl_type_to_symbol(cl_type t);
+
 /* unixint.d */
 
 #ifdef ECL_DEFINE_FENV_CONSTANTS
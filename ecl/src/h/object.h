@@ -257,8 +257,16 @@ struct ecl_symbol {
 	cl_object name;		/*  print name  */
 	cl_object hpack;	/*  home package  */
 				/*  Cnil for uninterned symbols  */
+#ifdef ECL_THREADS
+	cl_index binding;	/*  index into the thread-local  */
+				/*  bindings vector, or  */
+				/*  ECL_MISSING_SPECIAL_BINDING  */
+#endif
 };
 #define SYM_FUN(sym)	((sym)->symbol.gfdef)
+#ifdef ECL_THREADS
+#define ECL_MISSING_SPECIAL_BINDING	(~(cl_index)0)
+#endif
 
 struct ecl_package {
 	HEADER1(locked);
@@ -341,21 +349,35 @@ enum ecl_httest {		/*  hash table key test function  */
 	htt_pack		/*  symbol hash  */
 };
 
+enum ecl_htweak {		/*  hash table weakness  */
+	htw_none,		/*  strong references  */
+	htw_key,		/*  weak keys  */
+	htw_value,		/*  weak values  */
+	htw_key_and_value	/*  entry dies with key or value  */
+};
+
 struct ecl_hashtable_entry {	/*  hash table entry  */
 	cl_object key;		/*  key  */
 	cl_object value;	/*  value  */
+	cl_hashkey hash;	/*  hash code of the key  */
 };
 
 struct ecl_hashtable {		/*  hash table header  */
-	HEADER1(test);
+	HEADER2(test,weak);
 	struct ecl_hashtable_entry *data; /*  pointer to the hash table  */
 	cl_index entries;	/*  number of entries  */
-	cl_index size;		/*  hash table size  */
+	cl_index size;		/*  hash table size, a power of two  */
 	cl_object rehash_size;	/*  rehash size  */
 	cl_object threshold;	/*  rehash threshold  */
 	double factor;		/*  cached value of threshold  */
+	struct ecl_hashtable_entry *old_data; /*  vector being rehashed  */
+	cl_index old_size;	/*  its size, 0 when not rehashing  */
+	cl_index migrated;	/*  slots of old_data already moved  */
+	bool incremental;	/*  rehash a few slots at a time  */
 #ifdef ECL_THREADS
 	cl_object lock;		/*  mutex to prevent race conditions  */
+	cl_index version;	/*  odd while a synchronized table changes  */
+	bool sync;		/*  readers do not take the lock  */
 #endif
 };
 
@@ -581,12 +603,20 @@ enum {
 	ECL_STREAM_SIGNED_BYTES = 64,
 	ECL_STREAM_LITTLE_ENDIAN = 128,
 	ECL_STREAM_C_STREAM = 256,
-	ECL_STREAM_MIGHT_SEEK = 512
+	ECL_STREAM_MIGHT_SEEK = 512,
+	ECL_STREAM_LINE_BUFFERED = 1024,
+	ECL_STREAM_MMAP = 2048
 };
 
 typedef int (*cl_eformat_encoder)(cl_object stream, unsigned char *buffer, int c);
 typedef cl_index (*cl_eformat_read_byte8)(cl_object object, unsigned char *buffer, cl_index n);
 typedef int (*cl_eformat_decoder)(cl_object stream, cl_eformat_read_byte8 read_byte8, cl_object source);
+/* Encode up to *n characters into a buffer of SIZE bytes, leaving in *n
+ * how many of them fit, and return the number of bytes written. */
+typedef cl_index (*cl_eformat_encode_string)(cl_object stream, unsigned char *buffer, cl_index size, const ecl_character *chars, cl_index *n);
+/* Decode up to N characters out of *size bytes, leaving in *size how many
+ * bytes were used, and return the number of characters. */
+typedef cl_index (*cl_eformat_decode_string)(cl_object stream, const unsigned char *buffer, cl_index *size, ecl_character *chars, cl_index n);
 
 struct ecl_stream {
 	HEADER2(mode,closed);	/*  stream mode of enum smmode  */
@@ -605,10 +635,16 @@ struct ecl_stream {
 	cl_fixnum int1;		/*  some int  */
 	cl_index byte_size;	/*  size of byte in binary streams  */
 	cl_fixnum last_op;	/*  0: unknown, 1: reading, -1: writing */
-	char *buffer;		/*  buffer for FILE  */
+	char *buffer;		/*  buffer for FILE or POSIX file  */
+	cl_index buffer_size;	/*  size of buffer, 0 if POSIX file is unbuffered  */
+	cl_index buffer_pos;	/*  next byte to read, or output fill pointer  */
+	cl_index buffer_end;	/*  end of buffered input  */
+	cl_object mapping;	/*  vector over a memory mapped file  */
 	cl_object format;	/*  external format  */
 	cl_eformat_encoder encoder;
 	cl_eformat_decoder decoder;
+	cl_eformat_encode_string encode_string;	/*  NULL if only one at a time  */
+	cl_eformat_decode_string decode_string;
 	cl_object format_table;
 	int flags;		/*  character table, flags, etc  */
 };
@@ -687,6 +723,9 @@ struct ecl_bytecodes {
 	cl_index data_size;	/*  number of constants  */
 	char *code;		/*  the intermediate language  */
 	cl_object *data;	/*  non-inmediate constants used in the code  */
+	cl_index nlocals;	/*  size of the frame of local bindings  */
+	cl_object locals;	/*  names of the unboxed local variables  */
+	cl_object closure_map;	/*  where the closure environment comes from  */
 	cl_object file;		/*  file where it was defined...  */
 	cl_object file_position;/*  and where it was created  */
 };
@@ -694,7 +733,8 @@ struct ecl_bytecodes {
 struct ecl_bclosure {
 	HEADER;
 	cl_object code;
-	cl_object lex;
+	cl_object *lex;		/*  records of the closure environment,  */
+				/*  stored right after this structure  */
 	cl_objectfn entry;	/*  entry address  */
 };
 
@@ -885,6 +925,7 @@ struct ecl_instance {		/*  instance header  */
 	cl_objectfn entry;	/*  entry address  */
 	cl_object sig;		/*  generation signature  */
 	cl_object *slots;	/*  instance slots  */
+	cl_object cache;	/*  dispatch cache of generic functions  */
 };
 #endif /* CLOS */
 
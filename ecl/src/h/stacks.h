@@ -44,6 +44,8 @@ typedef struct bds_bd {
 typedef struct cl_env_struct *cl_env_ptr;
 
 #ifdef ECL_THREADS
+/* Marks a slot of env->thread_local_bindings without a dynamic binding */
+#define ECL_NO_TL_BINDING ((cl_object)(1 << 2))
 extern ECL_API void ecl_bds_bind(cl_env_ptr env, cl_object symbol, cl_object v);
 extern ECL_API void ecl_bds_push(cl_env_ptr env, cl_object symbol);
 extern ECL_API void ecl_bds_unwind1(cl_env_ptr env);
@@ -201,17 +203,22 @@ extern ECL_API ecl_frame_ptr _ecl_frs_push(register cl_env_ptr, register cl_obje
  * LEXICAL ENVIRONMENT STACK
  *****************************/
 /*
- * A lexical environment is a list of pairs, each one containing either
- * a variable definition, a tagbody or block tag, or a local function
- * definition.
+ * The bytecodes compiler assigns each lexical variable, block, tagbody
+ * and local function a slot in the frame of the function where it is
+ * bound. The interpreter keeps this frame in the lisp stack, right
+ * above the closure that is being executed, whose records are the
+ * bindings that the function references from its enclosing functions.
  *
- *	lex_env ---> ( { record }* )
- *	record = variable | function | block_tag | tagbody_tag
+ *	frame ---> closure[bclosure or NIL] { slot }*
+ *	slot = value | variable | function | block_tag | tagbody_tag
  *
  *	variable = ( var_name[symbol] . value )
- *	function = ( function[bytecodes] . fun_name[symbol] )
+ *	function = function[bytecodes or bclosure]
  *	block_tag = ( tag[fixnum] . block_name[symbol] )
  *	tagbody_tag = ( tag[fixnum] . 0 )
+ *
+ * Variables that are referenced from a closure are boxed in a
+ * variable record, the rest are stored unboxed in their slot.
  */
 
 /*************
@@ -75,12 +75,15 @@ Displays information about storage allocation in the following format.
 The number of times the garbage collector has been called is not shown, if the
 number is zero.  The optional X is simply ignored."
   #+boehm-gc
-  (progn
-    (format t "
-Unfortunately, when linked against the Boehm-Weiser garbage collector,
-ECL has no means to find out the amount of memory used. Please use
-some other routine (such as top in Unix or the Ctrl+Alt+Del combination
-in Windows) to learn this.")
+  (let ((census (ext:heap-census)))
+    (format t "~&~10@A ~14@A  ~A~%" "Objects" "Bytes" "Type")
+    (loop for (key count bytes) in census
+          for i from 0
+          while (or x (< i 20))
+          do (format t "~10D ~14D  ~S~%" count bytes key))
+    (format t "~10D ~14D  Total~%"
+            (reduce #'+ census :key #'second)
+            (reduce #'+ census :key #'third))
     (values))
   #-boehm-gc
   (let* (npage info-list link-alist)
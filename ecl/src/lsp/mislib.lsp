@@ -60,36 +60,34 @@ successfully, T is returned, else error."
 	     (/ (- run-end run-start) internal-time-units-per-second)
 	     (/ (- gc-end gc-start) internal-time-units-per-second))))
   #+boehm-gc
-  (let* (real-start
-	 run-start
-	 consed-start
-	 gc-no-start
+  (let* ((stats-start (ext:gc-statistics t))
+	 (real-start (get-internal-real-time))
+	 (run-start (get-internal-run-time))
 	 real-end
 	 run-end
-	 consed-end
-	 gc-no-end)
-    ;; Garbage collection forces the value of counters to be updated
-    (si::gc t)
-    (multiple-value-setq (consed-start gc-no-start) (gc-stats t))
-    (setq real-start (get-internal-real-time)
-	  run-start (get-internal-run-time))
+	 stats-end)
+    ;; The allocation counters of the current thread and the GC counters
+    ;; are always up to date, so we do not need to collect garbage here
     (multiple-value-prog1
 	(funcall closure)
       (setq run-end (get-internal-run-time)
-	    real-end (get-internal-real-time))
-      ;; Garbage collection forces the value of counters to be updated
-      (si::gc t)
-      (multiple-value-setq (consed-end gc-no-end) (gc-stats nil))
-      (fresh-line *trace-output*)
-      (format *trace-output*
-             "real time : ~,3F secs~%~
-              run time  : ~,3F secs~%~
-              gc count  : ~D times~%~
-              consed    : ~D bytes~%"
-	     (/ (- real-end real-start) internal-time-units-per-second)
-	     (/ (- run-end run-start) internal-time-units-per-second)
-	     (- gc-no-end gc-no-start)
-	     (- consed-end consed-start)))))
+	    real-end (get-internal-real-time)
+	    stats-end (ext:gc-statistics t))
+      (flet ((delta (key)
+	       (- (getf stats-end key) (getf stats-start key))))
+	(fresh-line *trace-output*)
+	(format *trace-output*
+		"real time : ~,3F secs~%~
+                 run time  : ~,3F secs~%~
+                 gc count  : ~D times~%~
+                 gc time   : ~,3F secs~%~
+                 consed    : ~D bytes in ~D objects~%"
+		(/ (- real-end real-start) internal-time-units-per-second)
+		(/ (- run-end run-start) internal-time-units-per-second)
+		(delta :gc-count)
+		(delta :gc-time)
+		(delta :bytes-allocated)
+		(delta :objects-allocated))))))
 
 (defmacro time (form)
   "Syntax: (time form)
@@ -97,6 +95,18 @@ Evaluates FORM, outputs the realtime and runtime used for the evaluation to
 *TRACE-OUTPUT*, and then returns all values of FORM."
   `(do-time #'(lambda () ,form)))
 
+(defmacro ext:with-allocation-region (&body body)
+  "Syntax: (ext:with-allocation-region &body body)
+Evaluates BODY and returns its values. The objects that BODY allocates in
+the current thread are given back to the garbage collector as soon as it
+returns, unless they can still be reached from elsewhere, in which case
+they are left to the collector as usual. Numbers, lists and vectors which
+are not displaced are copied out of the region when BODY returns them."
+  #+boehm-gc
+  `(si::call-with-allocation-region #'(lambda () ,@body))
+  #-boehm-gc
+  `(progn ,@body))
+
 (defun leap-year-p (y)
   (declare (si::c-local))
   (and (zerop (mod y 4))